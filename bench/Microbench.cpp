@@ -0,0 +1,50 @@
+#include "Microbench.h"
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+namespace cchess {
+namespace bench {
+
+double median(std::vector<double> values) {
+    if (values.empty())
+        return 0.0;
+    size_t mid = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(mid),
+                     values.end());
+    double upper = values[mid];
+    if (values.size() % 2 != 0)
+        return upper;
+    double lower = *std::max_element(values.begin(),
+                                     values.begin() + static_cast<std::ptrdiff_t>(mid));
+    return (lower + upper) / 2.0;
+}
+
+double medianAbsoluteDeviation(const std::vector<double>& values) {
+    double m = median(values);
+    std::vector<double> deviations;
+    deviations.reserve(values.size());
+    for (double v : values)
+        deviations.push_back(std::abs(v - m));
+    return median(std::move(deviations));
+}
+
+void Microbench::printHeader() {
+    std::cout << std::left << std::setw(36) << "benchmark" << std::right << std::setw(12)
+              << "ns/op" << std::setw(10) << "MAD" << std::setw(8) << "MAD%" << std::setw(12)
+              << "min" << std::setw(14) << "Mops/s" << "\n";
+    std::cout << std::string(92, '-') << "\n";
+}
+
+void Microbench::report(const BenchResult& r) {
+    double madPct = r.medianNs > 0.0 ? 100.0 * r.madNs / r.medianNs : 0.0;
+    double mops = r.medianNs > 0.0 ? 1000.0 / r.medianNs : 0.0;
+    std::cout << std::left << std::setw(36) << r.name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(12) << r.medianNs << std::setw(10) << r.madNs
+              << std::setprecision(1) << std::setw(7) << madPct << "%" << std::setprecision(2)
+              << std::setw(12) << r.minNs << std::setw(14) << mops << "\n";
+}
+
+}  // namespace bench
+}  // namespace cchess
@@ -0,0 +1,128 @@
+#ifndef CCHESS_MICROBENCH_H
+#define CCHESS_MICROBENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cchess {
+namespace bench {
+
+// Keeps the compiler from discarding a value computed only for timing.
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+struct BenchOptions {
+    std::chrono::milliseconds warmup{200};        // untimed calls before measuring
+    std::chrono::milliseconds minBatchTime{20};  // each timed batch runs at least this long
+    size_t batches = 30;
+    std::string filter;  // run only benchmarks whose name contains this
+};
+
+struct BenchResult {
+    std::string name;
+    double medianNs = 0.0;  // per operation
+    double madNs = 0.0;     // median absolute deviation of the batch times, per operation
+    double minNs = 0.0;
+    uint64_t opsPerBatch = 0;
+    size_t batches = 0;
+};
+
+// Median of the values (copied, since the median needs a partial sort).
+double median(std::vector<double> values);
+
+// Median absolute deviation from the median: a spread estimate that, unlike
+// the standard deviation, one interrupted batch cannot inflate.
+double medianAbsoluteDeviation(const std::vector<double>& values);
+
+// Runs kernels in isolation and prints one line per kernel.
+//
+// Each kernel is a callable doing opsPerCall operations per call. It is first
+// run untimed for the warm-up period (caches, branch predictors, CPU clock),
+// which also calibrates how many calls make a batch of at least minBatchTime.
+// Then each batch is timed, and the median and MAD of the per-operation times
+// are reported, so one slow batch (a context switch, an interrupt) does not
+// move the result.
+class Microbench {
+public:
+    explicit Microbench(BenchOptions options) : options_(std::move(options)) {}
+
+    template <typename Fn>
+    void run(const std::string& name, uint64_t opsPerCall, Fn&& fn);
+
+    const std::vector<BenchResult>& results() const { return results_; }
+
+    static void printHeader();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    bool selected(const std::string& name) const {
+        return options_.filter.empty() || name.find(options_.filter) != std::string::npos;
+    }
+    void report(const BenchResult& result);
+
+    BenchOptions options_;
+    std::vector<BenchResult> results_;
+};
+
+template <typename Fn>
+void Microbench::run(const std::string& name, uint64_t opsPerCall, Fn&& fn) {
+    if (!selected(name) || opsPerCall == 0)
+        return;
+
+    // Warm up, counting calls to size the batches
+    uint64_t warmupCalls = 0;
+    auto start = Clock::now();
+    auto elapsed = Clock::duration::zero();
+    do {
+        fn();
+        ++warmupCalls;
+        elapsed = Clock::now() - start;
+    } while (elapsed < options_.warmup);
+
+    double nsPerCall =
+        static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+        static_cast<double>(warmupCalls);
+    double batchNs = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(options_.minBatchTime).count());
+    uint64_t callsPerBatch = std::max<uint64_t>(1, static_cast<uint64_t>(batchNs / nsPerCall));
+
+    std::vector<double> perOp;
+    perOp.reserve(options_.batches);
+    for (size_t b = 0; b < options_.batches; ++b) {
+        auto batchStart = Clock::now();
+        for (uint64_t c = 0; c < callsPerBatch; ++c)
+            fn();
+        auto batchEnd = Clock::now();
+        double ns = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(batchEnd - batchStart).count());
+        perOp.push_back(ns / static_cast<double>(callsPerBatch * opsPerCall));
+    }
+
+    BenchResult result;
+    result.name = name;
+    result.medianNs = median(perOp);
+    result.madNs = medianAbsoluteDeviation(perOp);
+    result.minNs = *std::min_element(perOp.begin(), perOp.end());
+    result.opsPerBatch = callsPerBatch * opsPerCall;
+    result.batches = perOp.size();
+    report(result);
+    results_.push_back(std::move(result));
+}
+
+}  // namespace bench
+}  // namespace cchess
+
+#endif  // CCHESS_MICROBENCH_H
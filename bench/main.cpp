@@ -0,0 +1,286 @@
+// cchess_microbench: times core kernels in isolation.
+//
+// Usage: cchess_microbench [filter] [--epd <file>] [--batches N] [--batch-ms MS] [--warmup-ms MS]
+//   filter     Run only benchmarks whose name contains this substring
+//   --epd      Use the positions of an EPD/FEN file instead of the built-in set
+//
+// Every kernel runs over the same recorded position set, so a change to one
+// kernel shows up in its own row rather than as a shift in overall NPS.
+
+#include "Microbench.h"
+#include "ai/Eval.h"
+#include "ai/MoveOrder.h"
+#include "ai/PawnTable.h"
+#include "ai/TranspositionTable.h"
+#include "core/Board.h"
+#include "core/MoveList.h"
+#include "core/Notation.h"
+#include "core/Zobrist.h"
+#include "core/movegen/AttackTables.h"
+#include "core/movegen/MoveGenerator.h"
+#include "utils/CpuFeatures.h"
+#include "utils/MemoryUsage.h"
+#include "utils/StringUtils.h"
+
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace cchess;
+using namespace cchess::bench;
+
+namespace {
+
+// Openings, middlegames and endgames; quiet and tactical
+const char* const DEFAULT_POSITIONS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+    "r1bq1rk1/pp2ppbp/2np1np1/8/3NP3/2N1BP2/PPPQ2PP/R3KB1R w KQ - 3 9",
+    "r2q1rk1/1b1nbppp/p2ppn2/1p6/3NP3/1BN1BP2/PPPQ2PP/2KR3R w - - 0 12",
+    "2rq1rk1/pb1nbppp/1p2pn2/2pp4/2PP4/1PN1PN2/PB2BPPP/2RQ1RK1 w - - 4 12",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1",
+    "8/8/4k3/3p4/3P4/4K3/8/8 w - - 0 1",
+    "4r1k1/p4ppp/1p6/2p5/2P1nq2/1P3N2/P3QPPP/4R1K1 b - - 2 24",
+};
+
+std::vector<std::string> loadPositions(const std::string& path) {
+    std::vector<std::string> fens;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        line = trim(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+        // EPD lines carry four FEN fields followed by operations
+        std::istringstream fields(line);
+        std::string f[6];
+        int n = 0;
+        while (n < 6 && fields >> f[n])
+            ++n;
+        if (n < 4)
+            continue;
+        bool fullFen = n == 6 && std::isdigit(static_cast<unsigned char>(f[4][0])) &&
+                       std::isdigit(static_cast<unsigned char>(f[5][0]));
+        std::string fen = f[0] + " " + f[1] + " " + f[2] + " " + f[3];
+        fen += fullFen ? " " + f[4] + " " + f[5] : " 0 1";
+        fens.push_back(fen);
+    }
+    return fens;
+}
+
+struct Sample {
+    Board board;
+    MoveList moves;
+};
+
+// Cheap PRNG for table keys, so TT benchmarks touch the whole table
+struct SplitMix {
+    uint64_t state;
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+};
+
+void benchMoveExecution(Microbench& mb, std::vector<Sample>& samples, uint64_t totalMoves) {
+    mb.run("Position::makeMove+unmakeMove", totalMoves, [&] {
+        for (auto& s : samples) {
+            Position& pos = s.board.position();
+            for (const Move& m : s.moves) {
+                UndoInfo undo = pos.makeMove(m);
+                doNotOptimize(pos.hash());
+                pos.unmakeMove(m, undo);
+            }
+        }
+    });
+}
+
+void benchMoveGeneration(Microbench& mb, const std::vector<Sample>& samples) {
+    mb.run("generateLegalMoves", samples.size(), [&] {
+        for (const auto& s : samples)
+            doNotOptimize(MoveGenerator::generateLegalMoves(s.board.position()).size());
+    });
+    mb.run("generateLegalCaptures", samples.size(), [&] {
+        for (const auto& s : samples)
+            doNotOptimize(MoveGenerator::generateLegalCaptures(s.board.position()).size());
+    });
+}
+
+void benchAttacks(Microbench& mb, const std::vector<Sample>& samples) {
+    uint64_t ops = samples.size() * 64;
+    mb.run("isSquareAttacked", ops, [&] {
+        for (const auto& s : samples) {
+            const Position& pos = s.board.position();
+            Color them = ~pos.sideToMove();
+            for (int sq = 0; sq < 64; ++sq)
+                doNotOptimize(MoveGenerator::isSquareAttacked(pos, static_cast<Square>(sq), them));
+        }
+    });
+    mb.run("rookAttacks", ops, [&] {
+        for (const auto& s : samples) {
+            Bitboard occ = s.board.position().occupied();
+            for (int sq = 0; sq < 64; ++sq)
+                doNotOptimize(rookAttacks(static_cast<Square>(sq), occ));
+        }
+    });
+    mb.run("bishopAttacks", ops, [&] {
+        for (const auto& s : samples) {
+            Bitboard occ = s.board.position().occupied();
+            for (int sq = 0; sq < 64; ++sq)
+                doNotOptimize(bishopAttacks(static_cast<Square>(sq), occ));
+        }
+    });
+}
+
+void benchEval(Microbench& mb, const std::vector<Sample>& samples) {
+    mb.run("evaluate (pawn structure computed)", samples.size(), [&] {
+        for (const auto& s : samples)
+            doNotOptimize(eval::evaluate(s.board.position()));
+    });
+
+    // The set is far smaller than the table, so after the warm-up every probe hits
+    auto pawnTable = std::make_unique<eval::PawnTable>();
+    mb.run("evaluate (pawn table hit)", samples.size(), [&] {
+        for (const auto& s : samples)
+            doNotOptimize(eval::evaluate(s.board.position(), *pawnTable));
+    });
+}
+
+void benchTranspositionTable(Microbench& mb) {
+    constexpr uint64_t OPS = 4096;
+    for (size_t sizeMB : {size_t{1}, size_t{16}, size_t{256}}) {
+        TranspositionTable tt(sizeMB);
+        std::string suffix = " (" + std::to_string(sizeMB) + " MB)";
+        SplitMix storeKeys{1};
+        mb.run("TT::store" + suffix, OPS, [&] {
+            for (uint64_t i = 0; i < OPS; ++i)
+                tt.store(storeKeys.next(), static_cast<int>(i & 255), static_cast<int>(i & 15),
+                         TTBound::EXACT, Move{});
+        });
+        // Mostly misses on a full table: the cost is the cache line fetch
+        SplitMix probeKeys{2};
+        mb.run("TT::probe" + suffix, OPS, [&] {
+            TTEntry entry;
+            for (uint64_t i = 0; i < OPS; ++i)
+                doNotOptimize(tt.probe(probeKeys.next(), entry));
+        });
+    }
+}
+
+void benchOrdering(Microbench& mb, const std::vector<Sample>& samples) {
+    mb.run("MoveOrder::sort (incl. list copy)", samples.size(), [&] {
+        for (const auto& s : samples) {
+            MoveList moves = s.moves;
+            MoveOrder::sort(moves, s.board.position());
+            doNotOptimize(moves.begin());
+        }
+    });
+}
+
+void benchNotation(Microbench& mb, const std::vector<Sample>& samples, uint64_t totalMoves) {
+    mb.run("moveToSan", totalMoves, [&] {
+        for (const auto& s : samples) {
+            for (const Move& m : s.moves)
+                doNotOptimize(moveToSan(s.board, m).size());
+        }
+    });
+    mb.run("movesToSan (per move)", totalMoves, [&] {
+        for (const auto& s : samples)
+            doNotOptimize(movesToSan(s.board, s.moves).size());
+    });
+}
+
+void usage() {
+    std::cerr << "Usage: cchess_microbench [filter] [--epd <file>] [--batches N] "
+                 "[--batch-ms MS] [--warmup-ms MS]\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    zobrist::init();
+
+    BenchOptions options;
+    std::string epdPath;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            bool hasValue = i + 1 < argc;
+            if (std::strcmp(argv[i], "--epd") == 0 && hasValue)
+                epdPath = argv[++i];
+            else if (std::strcmp(argv[i], "--batches") == 0 && hasValue)
+                options.batches = std::max<size_t>(1, std::stoul(argv[++i]));
+            else if (std::strcmp(argv[i], "--batch-ms") == 0 && hasValue)
+                options.minBatchTime = std::chrono::milliseconds(std::stoi(argv[++i]));
+            else if (std::strcmp(argv[i], "--warmup-ms") == 0 && hasValue)
+                options.warmup = std::chrono::milliseconds(std::stoi(argv[++i]));
+            else if (argv[i][0] == '-') {
+                usage();
+                return 1;
+            } else
+                options.filter = argv[i];
+        }
+    } catch (const std::exception&) {
+        usage();
+        return 1;
+    }
+
+    std::vector<std::string> fens;
+    if (!epdPath.empty()) {
+        fens = loadPositions(epdPath);
+        if (fens.empty()) {
+            std::cerr << "No positions read from " << epdPath << "\n";
+            return 1;
+        }
+    } else {
+        fens.assign(std::begin(DEFAULT_POSITIONS), std::end(DEFAULT_POSITIONS));
+    }
+
+    std::vector<Sample> samples;
+    uint64_t totalMoves = 0;
+    for (const auto& fen : fens) {
+        try {
+            Board board(fen);
+            MoveList moves = board.getLegalMoves();
+            totalMoves += moves.size();
+            samples.push_back({board, moves});
+        } catch (const std::exception& e) {
+            std::cerr << "Skipping invalid FEN: " << fen << " (" << e.what() << ")\n";
+        }
+    }
+    if (samples.empty())
+        return 1;
+
+    std::cout << "Positions: " << samples.size() << " (" << totalMoves << " legal moves), "
+              << options.batches << " batches of >= " << options.minBatchTime.count()
+              << " ms, median and MAD per operation\n";
+    std::cout << "ISA: " << describeIsa() << "\n";
+    std::cout << "Memory: " << describeMemoryProfile() << "\n\n";
+
+    Microbench mb(options);
+    Microbench::printHeader();
+    benchMoveExecution(mb, samples, totalMoves);
+    benchMoveGeneration(mb, samples);
+    benchAttacks(mb, samples);
+    benchEval(mb, samples);
+    benchTranspositionTable(mb);
+    benchOrdering(mb, samples);
+    benchNotation(mb, samples, totalMoves);
+
+    std::cout << "\nPeak RSS: " << peakRssBytes() / (1024 * 1024) << " MB\n";
+    if (mb.results().empty()) {
+        std::cerr << "No benchmark matches \"" << options.filter << "\"\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,98 @@
+#ifndef CCHESS_CORRECTION_HISTORY_H
+#define CCHESS_CORRECTION_HISTORY_H
+
+#include "ai/TranspositionTable.h"
+#include "core/Bitboard.h"
+#include "core/Position.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+namespace cchess {
+
+// Static-eval correction history.
+//
+// The static evaluation is systematically wrong in some kinds of positions (a
+// pawn structure it misjudges, a material imbalance it undervalues). Whenever
+// a search returns a usable score for a quiet position, the difference between
+// that score and the raw eval is folded into two tables, one keyed by the pawn
+// hash and one by the material configuration, each split by side to move.
+// The learned error is then added back to the raw eval before it is used for
+// stand-pat and delta pruning.
+//
+// Each entry is a moving average of the error, scaled by GRAIN so that small
+// updates still register. Deeper results are more trustworthy and get a
+// larger weight; entries are clamped to [-LIMIT, LIMIT].
+//
+// Like the TT and pawn table, the tables belong to whoever runs the searches
+// and are kept across them, so the corrections keep learning over a game.
+class CorrectionHistory {
+public:
+    static constexpr int PAWN_SIZE = 1 << 14;  // per side, must be power of 2
+    static constexpr int MATERIAL_SIZE = 1 << 12;
+    static constexpr int GRAIN = 256;
+    static constexpr int LIMIT = 32 * GRAIN;  // corrections never exceed 32 cp
+    static constexpr int WEIGHT_SCALE = 256;
+    static constexpr int MAX_WEIGHT = 16;  // reached at depth 15
+
+    CorrectionHistory() { clear(); }
+
+    void clear() {
+        for (auto& side : pawn_)
+            side.fill(0);
+        for (auto& side : material_)
+            side.fill(0);
+    }
+
+    // Raw eval plus the learned correction for this position: the mean of the two
+    // tables' estimates, since each learns the whole error.
+    int correct(const Position& pos, int rawEval) const {
+        size_t side = static_cast<size_t>(pos.sideToMove());
+        int sum = pawn_[side][pawnIndex(pos)] + material_[side][materialIndex(pos)];
+        int corrected = rawEval + sum / (2 * GRAIN);
+        return std::clamp(corrected, -TT_MATE_THRESHOLD + 1, TT_MATE_THRESHOLD - 1);
+    }
+
+    // Learns from a search result for a position whose raw eval was rawEval.
+    // The caller only passes scores that bound the true value on the useful
+    // side (exact, or a fail-high above / fail-low below the eval).
+    void update(const Position& pos, int depth, int rawEval, int searchScore) {
+        assert(depth > 0);
+        int weight = std::min(depth + 1, MAX_WEIGHT);
+        int error = std::clamp((searchScore - rawEval) * GRAIN, -LIMIT, LIMIT);
+        size_t side = static_cast<size_t>(pos.sideToMove());
+        apply(pawn_[side][pawnIndex(pos)], error, weight);
+        apply(material_[side][materialIndex(pos)], error, weight);
+    }
+
+private:
+    static size_t pawnIndex(const Position& pos) {
+        return pos.pawnHash() & (PAWN_SIZE - 1);
+    }
+
+    // Piece counts packed in base 11 (at most 10 of a kind, counting
+    // promotions), then mixed so that similar counts spread over the table.
+    static size_t materialIndex(const Position& pos) {
+        uint64_t key = 0;
+        for (Color c : {Color::White, Color::Black}) {
+            for (PieceType pt : {PieceType::Pawn, PieceType::Knight, PieceType::Bishop,
+                                 PieceType::Rook, PieceType::Queen})
+                key = key * 11 + static_cast<uint64_t>(popCount(pos.pieces(pt, c)));
+        }
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 52) & (MATERIAL_SIZE - 1);
+    }
+
+    static void apply(int16_t& entry, int error, int weight) {
+        int e = (entry * (WEIGHT_SCALE - weight) + error * weight) / WEIGHT_SCALE;
+        entry = static_cast<int16_t>(std::clamp(e, -LIMIT, LIMIT));
+    }
+
+    std::array<std::array<int16_t, PAWN_SIZE>, 2> pawn_;
+    std::array<std::array<int16_t, MATERIAL_SIZE>, 2> material_;
+};
+
+}  // namespace cchess
+
+#endif  // CCHESS_CORRECTION_HISTORY_H
@@ -2,6 +2,7 @@
 
 #include "core/Bitboard.h"
 #include "core/movegen/AttackTables.h"
+#include "utils/CpuFeatures.h"
 
 #include <algorithm>
 
@@ -59,6 +60,7 @@ constexpr Score KING_OPEN_FILE_PENALTY = S(-10, 0);
 constexpr int KING_ATTACKER_WEIGHT[] = {0, 40, 30, 25, 50, 0};
 constexpr int KING_DANGER_DIVIDER = 8;  // penalty = danger² / KING_DANGER_DIVIDER (mg only)
 
+CCHESS_MULTIVERSION
 int gamePhase(const Position& pos) {
     int phase = 0;
     for (int pt = 1; pt < 5; ++pt) {
@@ -69,6 +71,7 @@ int gamePhase(const Position& pos) {
     return std::min(phase, TOTAL_PHASE);
 }
 
+CCHESS_MULTIVERSION
 Score bishopPair(const Position& pos) {
     Score score;
     if (popCount(pos.pieces(PieceType::Bishop, Color::White)) >= 2)
@@ -78,6 +81,7 @@ Score bishopPair(const Position& pos) {
     return score;
 }
 
+CCHESS_MULTIVERSION
 Score pawnStructure(Bitboard wp, Bitboard bp) {
     Score score;
     for (int f = 0; f < 8; ++f) {
@@ -98,6 +102,7 @@ Score pawnStructure(Bitboard wp, Bitboard bp) {
     return score;
 }
 
+CCHESS_MULTIVERSION
 Score passedPawns(Bitboard wp, Bitboard bp) {
     Score score;
 
@@ -128,6 +133,7 @@ Score passedPawns(Bitboard wp, Bitboard bp) {
     return score;
 }
 
+CCHESS_MULTIVERSION
 Score rookOpenFiles(const Position& pos, Bitboard wp, Bitboard bp) {
     Score score;
 
@@ -148,6 +154,7 @@ Score rookOpenFiles(const Position& pos, Bitboard wp, Bitboard bp) {
     return score;
 }
 
+CCHESS_MULTIVERSION
 Score pieceEval(const Position& pos, Bitboard wp, Bitboard bp, EvalState& state) {
     Score score;
     Bitboard occupied = pos.occupied();
@@ -237,6 +244,7 @@ Score pieceEval(const Position& pos, Bitboard wp, Bitboard bp, EvalState& state)
     return score;
 }
 
+CCHESS_MULTIVERSION
 Score mobility(const Position& pos) {
     Bitboard wp = pos.pieces(PieceType::Pawn, Color::White);
     Bitboard bp = pos.pieces(PieceType::Pawn, Color::Black);
@@ -249,6 +257,7 @@ static inline Bitboard kingZone(Square kingSq) {
     return KING_ATTACKS[kingSq] | squareBB(kingSq);
 }
 
+CCHESS_MULTIVERSION
 Score kingSafety(const Position& pos, Bitboard wp, Bitboard bp, const EvalState& state) {
     Score score;
 
@@ -333,6 +342,7 @@ Score kingSafety(const Position& pos, Bitboard wp, Bitboard bp, const EvalState&
     return score;
 }
 
+CCHESS_MULTIVERSION
 int evaluate(const Position& pos, Score pawnScore, Score passedScore) {
     Bitboard wp = pos.pieces(PieceType::Pawn, Color::White);
     Bitboard bp = pos.pieces(PieceType::Pawn, Color::Black);
@@ -348,6 +358,7 @@ int evaluate(const Position& pos, Score pawnScore, Score passedScore) {
     return (pos.sideToMove() == Color::White) ? tapered : -tapered;
 }
 
+CCHESS_MULTIVERSION
 int evaluate(const Position& pos, PawnTable& pt) {
     uint64_t pawnKey = pos.pawnHash();
     PawnEntry* pe = pt.probe(pawnKey);
@@ -361,6 +372,7 @@ int evaluate(const Position& pos, PawnTable& pt) {
     return evaluate(pos, pe->pawnScore, pe->passedScore);
 }
 
+CCHESS_MULTIVERSION
 int evaluate(const Position& pos) {
     Bitboard wp = pos.pieces(PieceType::Pawn, Color::White);
     Bitboard bp = pos.pieces(PieceType::Pawn, Color::Black);
@@ -0,0 +1,588 @@
+#include "ai/InterleavedSearch.h"
+
+#include "ai/CorrectionHistory.h"
+#include "ai/Eval.h"
+#include "ai/MoveOrder.h"
+#include "ai/PawnTable.h"
+#include "ai/Search.h"
+#include "ai/TranspositionTable.h"
+#include "core/Board.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Coroutine port of Search (see Search.cpp for the algorithm). The pruning,
+// reductions and move ordering are the same; the differences are:
+//   - fixed depth only (no clock, stop signal or node limit)
+//   - every child node is entered through prefetch + yield
+//   - no game history, so repetition is detected within the search path only
+
+namespace cchess {
+
+namespace {
+
+constexpr size_t ARENA_BYTES = size_t{1} << 20;  // ~2 KB per frame, MAX_PLY deep
+constexpr int MAX_HISTORY = 8192;                 // as in Search
+
+// Bump allocator for coroutine frames. Within one search, frames are created and
+// destroyed strictly LIFO (each child task is awaited to completion and destroyed
+// before its parent continues), so freeing a frame just rewinds the top.
+class FrameArena {
+public:
+    explicit FrameArena(size_t bytes)
+        : buffer_(std::make_unique<std::byte[]>(bytes)), size_(bytes) {}
+
+    void* allocate(size_t n) {
+        n = (n + ALIGN - 1) & ~(ALIGN - 1);
+        if (top_ + n > size_)
+            throw std::bad_alloc();
+        void* p = buffer_.get() + top_;
+        top_ += n;
+        return p;
+    }
+
+    void deallocate(void* p) {
+        auto* frame = static_cast<std::byte*>(p);
+        assert(frame >= buffer_.get() && frame < buffer_.get() + top_);
+        top_ = static_cast<size_t>(frame - buffer_.get());
+    }
+
+private:
+    static constexpr size_t ALIGN = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    std::unique_ptr<std::byte[]> buffer_;
+    size_t size_;
+    size_t top_ = 0;
+};
+
+// Arena of the search running on this thread; set by the scheduler before it
+// creates, resumes or destroys any of that search's frames.
+thread_local FrameArena* currentArena = nullptr;
+
+// Lazily started coroutine producing a score. co_await-ing a Task runs it and,
+// when it finishes, resumes the awaiter by symmetric transfer, so the recursion
+// does not grow the native stack across suspensions.
+class Task {
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(Handle h) const noexcept {
+            std::coroutine_handle<> next = h.promise().continuation;
+            return next ? next : std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    struct promise_type {
+        int value = 0;
+        std::coroutine_handle<> continuation;
+
+        Task get_return_object() { return Task(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_value(int v) { value = v; }
+        void unhandled_exception() const { std::terminate(); }
+
+        static void* operator new(size_t n) { return currentArena->allocate(n); }
+        static void operator delete(void* p) { currentArena->deallocate(p); }
+    };
+
+    Task() = default;
+    explicit Task(Handle h) : handle_(h) {}
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() { reset(); }
+
+    void reset() {
+        if (handle_)
+            handle_.destroy();
+        handle_ = nullptr;
+    }
+    Handle handle() const { return handle_; }
+    bool done() const { return handle_ && handle_.done(); }
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) const noexcept {
+        handle_.promise().continuation = awaiter;
+        return handle_;
+    }
+    int await_resume() const { return handle_.promise().value; }
+
+private:
+    Handle handle_;
+};
+
+class CoroSearcher;
+
+// Round-robin run queue of suspended searches.
+class Scheduler {
+public:
+    struct Entry {
+        std::coroutine_handle<> handle;
+        CoroSearcher* searcher;
+    };
+
+    void schedule(std::coroutine_handle<> h, CoroSearcher* searcher) {
+        ready_.push_back({h, searcher});
+    }
+
+    std::optional<Entry> next() {
+        if (ready_.empty())
+            return std::nullopt;
+        Entry e = ready_.front();
+        ready_.pop_front();
+        return e;
+    }
+
+private:
+    std::deque<Entry> ready_;
+};
+
+struct YieldAwaiter {
+    Scheduler& scheduler;
+    CoroSearcher* searcher;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) const { scheduler.schedule(h, searcher); }
+    void await_resume() const noexcept {}
+};
+
+// One in-flight search slot. Tables and the frame arena persist across the
+// positions the slot is given.
+class CoroSearcher {
+public:
+    CoroSearcher(size_t hashMB, Scheduler& scheduler)
+        : tt_(hashMB),
+          pawnTable_(std::make_unique<eval::PawnTable>()),
+          arena_(ARENA_BYTES),
+          scheduler_(scheduler) {}
+
+    // Iterative deepening to maxDepth on fen; the outcome is available from result()
+    // once the returned task is done.
+    Task searchPosition(std::string fen, int maxDepth);
+
+    InterleavedResult result() const { return result_; }
+    FrameArena& arena() { return arena_; }
+
+    Task root;            // the running searchPosition() task
+    size_t jobIndex = 0;  // index of the position being searched
+
+private:
+    Task negamax(int depth, int alpha, int beta, int ply, bool inCheck, bool nullOk = true);
+    Task quiescence(int alpha, int beta, int ply);
+
+    // Starts loading the tables for the current position, searched at depth, and lets the
+    // other searches run.
+    YieldAwaiter prefetchAndYield(int depth = TranspositionTable::DEEP) {
+        tt_.prefetch(board_.position().hash(), depth);
+        pawnTable_->prefetch(board_.position().pawnHash());
+        return {scheduler_, this};
+    }
+
+    bool isRepetition() const;
+    void storeKiller(int ply, const Move& move);
+    void updateHistory(int colorIdx, int from, int to, int bonus);
+
+    Board board_;
+    TranspositionTable tt_;
+    std::unique_ptr<eval::PawnTable> pawnTable_;
+    CorrectionHistory correction_;
+    FrameArena arena_;
+    Scheduler& scheduler_;
+
+    std::vector<uint64_t> searchStack_;
+    std::array<std::array<Move, 2>, MAX_PLY> killers_;
+    std::array<std::array<std::array<int, 64>, 64>, 2> history_{};
+    uint64_t nodes_ = 0;
+    InterleavedResult result_;
+};
+
+Task CoroSearcher::searchPosition(std::string fen, int maxDepth) {
+    board_ = Board(fen);
+    nodes_ = 0;
+    tt_.newSearch();
+    searchStack_.clear();
+    for (auto& pair : killers_)
+        pair[0] = pair[1] = Move{};
+    for (auto& colorTable : history_)
+        for (auto& fromRow : colorTable)
+            fromRow.fill(0);
+
+    Move bestMove;
+    int bestScoreOverall = 0;
+
+    maxDepth = std::min(maxDepth, MAX_SEARCH_DEPTH);
+    for (int depth = 1; depth <= maxDepth; ++depth) {
+        int alpha = -eval::SCORE_INFINITY;
+        int beta = eval::SCORE_INFINITY;
+        Move depthBest;
+        int bestScore = -eval::SCORE_INFINITY;
+
+        MoveList moves = board_.getLegalMoves();
+        if (moves.empty())
+            break;
+
+        Move ttMove;
+        TTEntry ttEntry;
+        if (tt_.probe(board_.position().hash(), ttEntry))
+            ttMove = ttEntry.bestMove();
+        MoveOrder::sort(moves, board_.position(), ttMove);
+
+        uint64_t rootHash = board_.position().hash();
+        for (size_t i = 0; i < moves.size(); ++i) {
+            searchStack_.push_back(rootHash);
+            UndoInfo undo = board_.makeMoveUnchecked(moves[i]);
+            ++nodes_;
+            co_await prefetchAndYield();
+
+            bool givesCheck = board_.isInCheck();
+
+            int score;
+            if (i == 0) {
+                score = -co_await negamax(depth - 1, -beta, -alpha, 1, givesCheck);
+            } else {
+                score = -co_await negamax(depth - 1, -alpha - 1, -alpha, 1, givesCheck);
+                if (score > alpha && score < beta)
+                    score = -co_await negamax(depth - 1, -beta, -alpha, 1, givesCheck);
+            }
+
+            board_.unmakeMove(moves[i], undo);
+            searchStack_.pop_back();
+
+            if (score > bestScore) {
+                bestScore = score;
+                depthBest = moves[i];
+            }
+            if (score > alpha)
+                alpha = score;
+        }
+
+        bestMove = depthBest;
+        bestScoreOverall = bestScore;
+        tt_.store(board_.position().hash(), scoreToTT(bestScore, 0), depth, TTBound::EXACT,
+                  bestMove);
+
+        if (bestScore >= eval::SCORE_MATE - maxDepth)
+            break;
+    }
+
+    result_.bestMove = bestMove;
+    result_.score = bestScoreOverall;
+    result_.nodes = nodes_;
+    co_return 0;
+}
+
+Task CoroSearcher::negamax(int depth, int alpha, int beta, int ply, bool inCheck, bool nullOk) {
+    assert(alpha < beta);
+    assert(depth >= 0);
+    assert(ply >= 0 && ply < MAX_PLY);
+
+    if (board_.isDraw() || isRepetition())
+        co_return eval::SCORE_DRAW;
+
+    if (depth == 0 || ply >= MAX_PLY - 1)
+        co_return co_await quiescence(alpha, beta, ply);
+
+    Move ttMove;
+    int rawEval = TTEntry::NO_EVAL;
+    uint64_t posHash = board_.position().hash();
+    bool isPvNode = (beta - alpha > 1);
+    TTEntry ttEntry;
+    if (tt_.probe(posHash, ttEntry, depth)) {
+        ttMove = ttEntry.bestMove();
+        rawEval = ttEntry.eval;
+        if (ttEntry.depth >= depth && !isPvNode) {
+            int ttScore = scoreFromTT(ttEntry.score, ply);
+            TTBound bound = ttEntry.bound();
+            if (bound == TTBound::EXACT || (bound == TTBound::LOWER && ttScore >= beta) ||
+                (bound == TTBound::UPPER && ttScore <= alpha)) {
+                ++tt_.stats().cutoffs;
+                co_return ttScore;
+            }
+        }
+    }
+
+    constexpr int NMP_REDUCTION = 2;
+    if (nullOk && !isPvNode && !inCheck && depth >= 3) {
+        Square prevEp = board_.enPassantSquare();
+        uint64_t prevHash = board_.position().hash();
+        board_.makeNullMove();
+        co_await prefetchAndYield(depth - 1 - NMP_REDUCTION);
+        int nullScore =
+            -co_await negamax(depth - 1 - NMP_REDUCTION, -beta, -beta + 1, ply + 1, false, false);
+        board_.unmakeNullMove(prevEp, prevHash);
+
+        if (nullScore >= beta)
+            co_return beta;
+    }
+
+    MoveList moves = board_.getLegalMoves();
+    if (moves.empty())
+        co_return inCheck ? -(eval::SCORE_MATE - ply) : eval::SCORE_DRAW;
+
+    const Move* killers = killers_[static_cast<size_t>(ply)].data();
+    int colorIdx = board_.position().sideToMove() == Color::White ? 0 : 1;
+    MoveOrder::sort(moves, board_.position(), ttMove, killers,
+                    history_[static_cast<size_t>(colorIdx)]);
+
+    int bestScore = -eval::SCORE_INFINITY;
+    Move bestMoveInNode;
+    int origAlpha = alpha;
+
+    Move quietsSearched[MAX_PLY];
+    int quietsCount = 0;
+
+    for (size_t i = 0; i < moves.size(); ++i) {
+        searchStack_.push_back(posHash);
+        UndoInfo undo = board_.makeMoveUnchecked(moves[i]);
+        ++nodes_;
+        co_await prefetchAndYield(depth - 1);
+
+        bool givesCheck = board_.isInCheck();
+
+        int score;
+        if (i == 0) {
+            score = -co_await negamax(depth - 1, -beta, -alpha, ply + 1, givesCheck);
+        } else {
+            int reduction = 0;
+            bool isQuiet = !moves[i].isCapture() && !moves[i].isPromotion();
+            if (depth >= 3 && i >= 2 && !inCheck && !givesCheck && isQuiet) {
+                reduction = Search::lmrReduction(depth, i);
+                int histScore =
+                    history_[static_cast<size_t>(colorIdx)][static_cast<size_t>(static_cast<int>(
+                        moves[i].from()))][static_cast<size_t>(static_cast<int>(moves[i].to()))];
+                reduction -= histScore / MAX_HISTORY;
+                reduction = std::clamp(reduction, 0, depth - 2);
+            }
+
+            score = -co_await negamax(depth - 1 - reduction, -alpha - 1, -alpha, ply + 1,
+                                      givesCheck);
+            if (reduction > 0 && score > alpha)
+                score = -co_await negamax(depth - 1, -alpha - 1, -alpha, ply + 1, givesCheck);
+            if (score > alpha && score < beta)
+                score = -co_await negamax(depth - 1, -beta, -alpha, ply + 1, givesCheck);
+        }
+
+        board_.unmakeMove(moves[i], undo);
+        searchStack_.pop_back();
+
+        if (!moves[i].isCapture() && !moves[i].isPromotion() && quietsCount < MAX_PLY)
+            quietsSearched[quietsCount++] = moves[i];
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestMoveInNode = moves[i];
+        }
+        if (score > alpha)
+            alpha = score;
+        if (alpha >= beta) {
+            if (!moves[i].isCapture() && !moves[i].isPromotion()) {
+                storeKiller(ply, moves[i]);
+                int bonus = std::min(depth * depth, MAX_HISTORY);
+                updateHistory(colorIdx, static_cast<int>(moves[i].from()),
+                              static_cast<int>(moves[i].to()), bonus);
+                for (int q = 0; q < quietsCount - 1; ++q) {
+                    updateHistory(colorIdx, static_cast<int>(quietsSearched[q].from()),
+                                  static_cast<int>(quietsSearched[q].to()), -bonus);
+                }
+            }
+            break;
+        }
+    }
+
+    TTBound bound;
+    if (alpha >= beta)
+        bound = TTBound::LOWER;
+    else if (bestScore > origAlpha)
+        bound = TTBound::EXACT;
+    else
+        bound = TTBound::UPPER;
+
+    bool quietBest = bestMoveInNode.isNull() ||
+                     (!bestMoveInNode.isCapture() && !bestMoveInNode.isPromotion());
+    bool learn = !inCheck && quietBest && std::abs(bestScore) < TT_MATE_THRESHOLD;
+    if (learn && rawEval == TTEntry::NO_EVAL)
+        rawEval = eval::evaluate(board_.position(), *pawnTable_);
+    tt_.store(posHash, scoreToTT(bestScore, ply), depth, bound, bestMoveInNode, rawEval);
+
+    if (learn) {
+        if (bound == TTBound::EXACT || (bound == TTBound::LOWER && bestScore > rawEval) ||
+            (bound == TTBound::UPPER && bestScore < rawEval))
+            correction_.update(board_.position(), depth, rawEval, bestScore);
+    }
+
+    co_return bestScore;
+}
+
+Task CoroSearcher::quiescence(int alpha, int beta, int ply) {
+    assert(alpha < beta);
+    assert(ply >= 0 && ply < MAX_PLY);
+
+    int rawEval = TTEntry::NO_EVAL;
+    uint64_t posHash = board_.position().hash();
+    TTEntry ttEntry;
+    if (tt_.probe(posHash, ttEntry, 0)) {
+        rawEval = ttEntry.eval;
+        int ttScore = scoreFromTT(ttEntry.score, ply);
+        TTBound bound = ttEntry.bound();
+        if (bound == TTBound::EXACT || (bound == TTBound::LOWER && ttScore >= beta) ||
+            (bound == TTBound::UPPER && ttScore <= alpha)) {
+            ++tt_.stats().cutoffs;
+            co_return ttScore;
+        }
+    }
+
+    if (rawEval == TTEntry::NO_EVAL)
+        rawEval = eval::evaluate(board_.position(), *pawnTable_);
+    int standPat = correction_.correct(board_.position(), rawEval);
+    if (ply >= MAX_PLY - 1)
+        co_return standPat;
+    if (standPat >= beta)
+        co_return beta;
+
+    int origAlpha = alpha;
+    int bestScore = standPat;
+
+    constexpr int DELTA_MAX_GAIN = eval::PIECE_VALUE_MG[static_cast<int>(PieceType::Queen)];
+    constexpr int DELTA_PROMO_BONUS = eval::PIECE_VALUE_MG[static_cast<int>(PieceType::Queen)] -
+                                      eval::PIECE_VALUE_MG[static_cast<int>(PieceType::Pawn)];
+    constexpr int DELTA_MARGIN = 350;
+    bool hasPromotingPawn =
+        (board_.position().pieces(PieceType::Pawn, Color::White) & RANK_BB[RANK_7]) ||
+        (board_.position().pieces(PieceType::Pawn, Color::Black) & RANK_BB[RANK_2]);
+    if (standPat < alpha - DELTA_MAX_GAIN - (hasPromotingPawn ? DELTA_PROMO_BONUS : 0))
+        co_return standPat;
+
+    if (standPat > alpha)
+        alpha = standPat;
+    Move bestMoveInNode;
+
+    MoveList captures = board_.getLegalCaptures();
+    MoveOrder::sort(captures, board_.position());
+
+    for (size_t i = 0; i < captures.size(); ++i) {
+        if (!captures[i].isPromotion() && !captures[i].isEnPassant()) {
+            PieceType captured = board_.position().pieceAt(captures[i].to()).type();
+            if (standPat + eval::PIECE_VALUE_MG[static_cast<int>(captured)] + DELTA_MARGIN < alpha)
+                continue;
+        }
+
+        UndoInfo undo = board_.makeMoveUnchecked(captures[i]);
+        ++nodes_;
+        co_await prefetchAndYield(0);
+        int score = -co_await quiescence(-beta, -alpha, ply + 1);
+        board_.unmakeMove(captures[i], undo);
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestMoveInNode = captures[i];
+        }
+        if (score > alpha)
+            alpha = score;
+        if (alpha >= beta)
+            break;
+    }
+
+    TTBound bound;
+    if (bestScore >= beta)
+        bound = TTBound::LOWER;
+    else if (bestScore > origAlpha)
+        bound = TTBound::EXACT;
+    else
+        bound = TTBound::UPPER;
+    tt_.store(posHash, scoreToTT(bestScore, ply), 0, bound, bestMoveInNode, rawEval);
+
+    co_return bestScore;
+}
+
+bool CoroSearcher::isRepetition() const {
+    uint64_t hash = board_.position().hash();
+    int searchSize = static_cast<int>(searchStack_.size());
+    int lookback = std::min(searchSize, board_.position().halfmoveClock());
+    for (int i = searchSize - 1; i >= searchSize - lookback; --i) {
+        if (searchStack_[static_cast<size_t>(i)] == hash)
+            return true;
+    }
+    return false;
+}
+
+void CoroSearcher::storeKiller(int ply, const Move& move) {
+    auto p = static_cast<size_t>(ply);
+    if (killers_[p][0] == move)
+        return;
+    killers_[p][1] = killers_[p][0];
+    killers_[p][0] = move;
+}
+
+void CoroSearcher::updateHistory(int colorIdx, int from, int to, int bonus) {
+    int b = std::clamp(bonus, -MAX_HISTORY, MAX_HISTORY);
+    auto& h = history_[static_cast<size_t>(colorIdx)][static_cast<size_t>(from)]
+                      [static_cast<size_t>(to)];
+    h += b - h * std::abs(b) / MAX_HISTORY;
+}
+
+}  // namespace
+
+std::vector<InterleavedResult> InterleavedSearch::run(const std::vector<std::string>& fens,
+                                                      int depth, size_t width, size_t hashMB) {
+    std::vector<InterleavedResult> results(fens.size());
+    if (fens.empty())
+        return results;
+    width = std::clamp(width, size_t{1}, fens.size());
+
+    Scheduler scheduler;
+    std::vector<std::unique_ptr<CoroSearcher>> searchers;
+    size_t next = 0;
+
+    auto startNext = [&](CoroSearcher& searcher) {
+        searcher.jobIndex = next++;
+        currentArena = &searcher.arena();
+        searcher.root = searcher.searchPosition(fens[searcher.jobIndex], depth);
+        scheduler.schedule(searcher.root.handle(), &searcher);
+    };
+
+    for (size_t i = 0; i < width; ++i) {
+        searchers.push_back(std::make_unique<CoroSearcher>(hashMB, scheduler));
+        startNext(*searchers.back());
+    }
+
+    while (auto entry = scheduler.next()) {
+        CoroSearcher& searcher = *entry->searcher;
+        currentArena = &searcher.arena();
+        entry->handle.resume();
+
+        if (searcher.root.done()) {
+            results[searcher.jobIndex] = searcher.result();
+            searcher.root.reset();
+            if (next < fens.size())
+                startNext(searcher);
+        }
+    }
+
+    currentArena = nullptr;
+    return results;
+}
+
+}  // namespace cchess
@@ -0,0 +1,40 @@
+#ifndef CCHESS_INTERLEAVED_SEARCH_H
+#define CCHESS_INTERLEAVED_SEARCH_H
+
+#include "core/Move.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cchess {
+
+struct InterleavedResult {
+    Move bestMove;
+    int score = 0;
+    uint64_t nodes = 0;
+};
+
+// Runs many independent fixed-depth searches on the calling thread, interleaved
+// as C++20 coroutines (only built with -DENABLE_COROUTINES=ON).
+//
+// Each search is a coroutine port of Search's negamax/quiescence. Before
+// recursing into a child it prefetches the child's TT cluster and pawn-table
+// entry and then yields, so the scheduler can run the other searches while the
+// cache lines are in flight. The probe happens when the search is resumed. This
+// keeps `width` searches in flight, like one game per coroutine in self-play or
+// datagen, and trades a little switching overhead for hidden DRAM latency. With
+// width 1 the yields resume straight away, which isolates that overhead.
+//
+// Every slot owns its TT (hashMB), pawn table and coroutine frame arena. A slot
+// keeps them across the positions it searches, as one game does across its moves.
+class InterleavedSearch {
+public:
+    static std::vector<InterleavedResult> run(const std::vector<std::string>& fens, int depth,
+                                              size_t width, size_t hashMB);
+};
+
+}  // namespace cchess
+
+#endif  // CCHESS_INTERLEAVED_SEARCH_H
@@ -0,0 +1,269 @@
+#include "ai/MateSolver.h"
+
+#include "core/MoveList.h"
+#include "core/movegen/MoveGenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+namespace cchess {
+
+namespace {
+
+constexpr size_t MAX_CHILDREN = 256;
+constexpr uint64_t PLY_KEY = 0x9E3779B97F4A7C15ULL;  // golden-ratio multiplier
+
+uint32_t saturatingAdd(uint32_t a, uint32_t b, uint32_t limit) {
+    uint64_t sum = uint64_t{a} + b;
+    return static_cast<uint32_t>(std::min<uint64_t>(sum, limit));
+}
+
+}  // namespace
+
+MateSolver::MateSolver(size_t hashMB) {
+    size_t buckets = std::max<size_t>(1, hashMB * 1024 * 1024 / (sizeof(Entry) * BUCKET_SIZE));
+    size_t pow2 = 1;
+    while (pow2 * 2 <= buckets)
+        pow2 *= 2;
+    table_.assign(pow2 * BUCKET_SIZE, Entry{});
+    bucketMask_ = pow2 - 1;
+}
+
+void MateSolver::clear() {
+    std::fill(table_.begin(), table_.end(), Entry{});
+}
+
+// The remaining plies are folded into the key: a position with three plies to go
+// is a different problem from the same position with five.
+uint64_t MateSolver::keyFor(const Position& pos, int plies) {
+    return pos.hash() ^ (static_cast<uint64_t>(plies + 1) * PLY_KEY);
+}
+
+bool MateSolver::lookup(uint64_t key, Bounds& out) const {
+    const Entry* bucket = &table_[(key & bucketMask_) * BUCKET_SIZE];
+    for (size_t i = 0; i < BUCKET_SIZE; ++i) {
+        if (bucket[i].key == key) {
+            out = bucket[i].bounds;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Replaces the same key, else an empty slot, else the entry nearest its start
+// values (the least work invested). Solved entries are kept as long as possible.
+void MateSolver::store(uint64_t key, const Bounds& bounds) {
+    Entry* bucket = &table_[(key & bucketMask_) * BUCKET_SIZE];
+    Entry* victim = nullptr;
+    uint64_t victimWork = UINT64_MAX;
+    for (size_t i = 0; i < BUCKET_SIZE; ++i) {
+        Entry& e = bucket[i];
+        if (e.key == key || e.key == 0) {
+            victim = &e;
+            break;
+        }
+        bool solved = e.bounds.phi == 0 || e.bounds.delta == 0;
+        uint64_t work = solved ? UINT64_MAX - 1 : uint64_t{e.bounds.phi} + e.bounds.delta;
+        if (work < victimWork) {
+            victimWork = work;
+            victim = &e;
+        }
+    }
+    victim->key = key;
+    victim->bounds = bounds;
+}
+
+void MateSolver::checkLimits() {
+    if (config_.stopSignal && config_.stopSignal->load()) {
+        stopped_ = true;
+        return;
+    }
+    if (config_.maxNodes > 0 && nodes_ >= config_.maxNodes) {
+        stopped_ = true;
+        return;
+    }
+    if (std::chrono::steady_clock::now() - startTime_ >= config_.timeLimit)
+        stopped_ = true;
+}
+
+// Multiple iterative deepening: expands the node until its proof or disproof
+// number reaches the threshold, always descending into the child that is
+// cheapest to settle. The attacker moves when an odd number of plies remain.
+MateSolver::Bounds MateSolver::mid(Position& pos, int plies, uint32_t thPhi, uint32_t thDelta) {
+    assert(plies >= 0);
+    ++nodes_;
+    if ((nodes_ & 1023) == 0)
+        checkLimits();
+
+    const bool attacker = (plies & 1) != 0;
+    const uint64_t key = keyFor(pos, plies);
+    MoveList moves = MoveGenerator::generateLegalMoves(pos);
+
+    // Terminal: mate, stalemate, or the defender has survived the last ply
+    if (moves.empty() || plies == 0) {
+        // Stalemate counts as a loss for the attacker, whichever side is stalemated
+        bool moverLost = moves.empty() &&
+                         (attacker || MoveGenerator::isInCheck(pos, pos.sideToMove()));
+        Bounds result = moverLost ? Bounds{INF, 0} : Bounds{0, INF};
+        store(key, result);
+        return result;
+    }
+
+    // Children start from the table, or from a guess: for the attacker, checks
+    // are cheaper to prove than quiet moves
+    std::array<Bounds, MAX_CHILDREN> children;
+    const size_t count = moves.size();
+    for (size_t i = 0; i < count; ++i) {
+        UndoInfo undo = pos.makeMove(moves[i]);
+        if (!lookup(keyFor(pos, plies - 1), children[i])) {
+            bool givesCheck = MoveGenerator::isInCheck(pos, pos.sideToMove());
+            children[i] = {1, attacker && !givesCheck ? 2u : 1u};
+        }
+        pos.unmakeMove(moves[i], undo);
+    }
+
+    Bounds node{};
+    while (!stopped_) {
+        // phi = min delta(child), delta = sum phi(child)
+        uint32_t minDelta = INF;
+        uint32_t secondDelta = INF;
+        uint32_t sumPhi = 0;
+        size_t best = 0;
+        for (size_t i = 0; i < count; ++i) {
+            sumPhi = saturatingAdd(sumPhi, children[i].phi, INF);
+            if (children[i].delta < minDelta) {
+                secondDelta = minDelta;
+                minDelta = children[i].delta;
+                best = i;
+            } else if (children[i].delta < secondDelta) {
+                secondDelta = children[i].delta;
+            }
+        }
+        node = {minDelta, sumPhi};
+        if (node.phi >= thPhi || node.delta >= thDelta)
+            break;
+
+        uint32_t childThPhi = saturatingAdd(thDelta - node.delta, children[best].phi, INF);
+        uint32_t childThDelta = std::min(thPhi, saturatingAdd(secondDelta, 1, INF));
+
+        UndoInfo undo = pos.makeMove(moves[best]);
+        children[best] = mid(pos, plies - 1, childThPhi, childThDelta);
+        pos.unmakeMove(moves[best], undo);
+    }
+
+    if (!stopped_)
+        store(key, node);
+    return node;
+}
+
+// Moves that keep the proof of a proven position: every reply at defender nodes,
+// and at attacker nodes the moves whose result is still in the table. If every
+// proving entry has been replaced, the moves are re-solved until one proves.
+MoveList MateSolver::provingMoves(Position& pos, int plies) {
+    MoveList moves = MoveGenerator::generateLegalMoves(pos);
+    if ((plies & 1) == 0)
+        return moves;
+
+    MoveList proving;
+    for (const Move& move : moves) {
+        UndoInfo undo = pos.makeMove(move);
+        Bounds child;
+        if (lookup(keyFor(pos, plies - 1), child) && child.delta == 0)
+            proving.push_back(move);
+        pos.unmakeMove(move, undo);
+    }
+    for (size_t i = 0; proving.empty() && i < moves.size(); ++i) {
+        UndoInfo undo = pos.makeMove(moves[i]);
+        if (mid(pos, plies - 1, INF, INF).delta == 0)
+            proving.push_back(moves[i]);
+        pos.unmakeMove(moves[i], undo);
+    }
+    return proving;
+}
+
+// Size of the proof tree below a proven position: one proving move at attacker
+// nodes, every reply at defender nodes. Shared subtrees are counted once per parent.
+uint64_t MateSolver::proofSize(Position& pos, int plies,
+                               std::unordered_map<uint64_t, uint64_t>& memo) {
+    uint64_t key = keyFor(pos, plies);
+    auto it = memo.find(key);
+    if (it != memo.end())
+        return it->second;
+
+    uint64_t size = 1;
+    if (plies > 0) {
+        MoveList moves = provingMoves(pos, plies);
+        size_t used = (plies & 1) ? std::min<size_t>(moves.size(), 1) : moves.size();
+        for (size_t i = 0; i < used; ++i) {
+            UndoInfo undo = pos.makeMove(moves[i]);
+            size += proofSize(pos, plies - 1, memo);
+            pos.unmakeMove(moves[i], undo);
+        }
+    }
+    memo.emplace(key, size);
+    return size;
+}
+
+// Main line of the proof: the attacker plays the move with the smallest proof,
+// the defender the reply with the largest (the most stubborn defence).
+void MateSolver::extractPv(Position& pos, int plies, std::unordered_map<uint64_t, uint64_t>& memo,
+                           std::vector<Move>& pv) {
+    for (; plies > 0; --plies) {
+        bool attacker = (plies & 1) != 0;
+        Move chosen;
+        uint64_t chosenSize = 0;
+        for (const Move& move : provingMoves(pos, plies)) {
+            UndoInfo undo = pos.makeMove(move);
+            uint64_t sub = proofSize(pos, plies - 1, memo);
+            pos.unmakeMove(move, undo);
+            if (chosen.isNull() || (attacker ? sub < chosenSize : sub > chosenSize)) {
+                chosen = move;
+                chosenSize = sub;
+            }
+        }
+        if (chosen.isNull())
+            break;  // mated
+        pv.push_back(chosen);
+        pos.makeMove(chosen);
+    }
+}
+
+MateResult MateSolver::solve(const Board& board, const MateSolverConfig& config) {
+    config_ = config;
+    startTime_ = std::chrono::steady_clock::now();
+    nodes_ = 0;
+    stopped_ = false;
+
+    MateResult result;
+    Position root = board.position();
+    for (int n = 1; n <= config_.maxMoves && !stopped_; ++n) {
+        int plies = 2 * n - 1;
+        Bounds b = mid(root, plies, INF, INF);
+        if (stopped_)
+            break;
+        if (b.phi == 0) {
+            // Reading the proof back may re-prove replaced entries; let it finish
+            config_.stopSignal = nullptr;
+            config_.maxNodes = 0;
+            config_.timeLimit = std::chrono::hours(24);
+            result.found = true;
+            result.mateIn = n;
+            std::unordered_map<uint64_t, uint64_t> memo;
+            result.proofSize = proofSize(root, plies, memo);
+            Position line = root;
+            extractPv(line, plies, memo, result.pv);
+            if (!result.pv.empty())
+                result.bestMove = result.pv.front();
+            break;
+        }
+    }
+    result.disproven = !result.found && !stopped_;
+    result.nodes = nodes_;
+    result.timeMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                         std::chrono::steady_clock::now() - startTime_)
+                                         .count());
+    return result;
+}
+
+}  // namespace cchess
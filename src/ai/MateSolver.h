@@ -0,0 +1,102 @@
+#ifndef CCHESS_MATE_SOLVER_H
+#define CCHESS_MATE_SOLVER_H
+
+#include "core/Board.h"
+#include "core/Move.h"
+#include "core/MoveList.h"
+#include "core/Position.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace cchess {
+
+struct MateSolverConfig {
+    int maxMoves = 5;                         // look for mates in up to this many moves
+    std::chrono::milliseconds timeLimit{10000};
+    uint64_t maxNodes{0};                     // 0 = no node limit
+    std::atomic<bool>* stopSignal = nullptr;  // external stop (for UCI "stop")
+};
+
+struct MateResult {
+    bool found = false;      // a forced mate was proven
+    bool disproven = false;  // no mate in maxMoves exists (as opposed to running out of time)
+    int mateIn = 0;          // moves of the side to move, when found
+    Move bestMove;
+    std::vector<Move> pv;    // the proof's main line, ending in mate
+    uint64_t nodes = 0;
+    uint64_t proofSize = 0;  // positions in the proof tree
+    int timeMs = 0;
+
+    uint64_t nps() const {
+        return timeMs > 0 ? nodes * 1000 / static_cast<uint64_t>(timeMs) : nodes * 1000;
+    }
+};
+
+// Depth-first proof-number search (df-pn) for forced mates.
+//
+// Alpha-beta spends most of its effort on moves that are refuted by a single
+// reply, and proves a mate in N only once every line is searched to full depth.
+// Proof-number search instead grows the tree where the fewest positions remain
+// to be settled: a position where the attacker has one checking move is cheap
+// to prove, a position with thirty defences is expensive. Each node carries a
+// proof number (positions left to prove the mate) and a disproof number
+// (positions left to refute it), stored from the mover's point of view as
+// phi/delta so attacker and defender nodes share one code path.
+//
+// Mates are searched for N = 1, 2, ... up to maxMoves, so the first proof is the
+// shortest mate. The remaining ply budget is part of each table key, which keeps
+// the search graph acyclic (repetitions simply use up plies).
+class MateSolver {
+public:
+    static constexpr size_t DEFAULT_HASH_MB = 16;
+
+    explicit MateSolver(size_t hashMB = DEFAULT_HASH_MB);
+
+    MateResult solve(const Board& board, const MateSolverConfig& config);
+
+    // Forgets all proofs. Entries stay valid between positions, so a batch of
+    // related positions can share them.
+    void clear();
+
+private:
+    struct Bounds {
+        uint32_t phi;    // proof number for the side to move
+        uint32_t delta;  // disproof number for the side to move
+    };
+
+    // 16 bytes, four to a cache line
+    struct Entry {
+        uint64_t key;
+        Bounds bounds;
+    };
+    static constexpr size_t BUCKET_SIZE = 4;
+    static constexpr uint32_t INF = 1u << 28;
+
+    static uint64_t keyFor(const Position& pos, int plies);
+    bool lookup(uint64_t key, Bounds& out) const;
+    void store(uint64_t key, const Bounds& bounds);
+
+    Bounds mid(Position& pos, int plies, uint32_t thPhi, uint32_t thDelta);
+    MoveList provingMoves(Position& pos, int plies);
+    uint64_t proofSize(Position& pos, int plies, std::unordered_map<uint64_t, uint64_t>& memo);
+    void extractPv(Position& pos, int plies, std::unordered_map<uint64_t, uint64_t>& memo,
+                   std::vector<Move>& pv);
+    void checkLimits();
+
+    std::vector<Entry> table_;
+    size_t bucketMask_;
+
+    MateSolverConfig config_;
+    std::chrono::steady_clock::time_point startTime_;
+    uint64_t nodes_ = 0;
+    bool stopped_ = false;
+};
+
+}  // namespace cchess
+
+#endif  // CCHESS_MATE_SOLVER_H
@@ -6,6 +6,10 @@
 #include <algorithm>
 #include <cstdint>
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 namespace cchess {
 namespace eval {
 
@@ -19,13 +23,26 @@ struct PawnEntry {
 
 class PawnTable {
 public:
+#ifdef CCHESS_LOW_MEMORY
+    static constexpr int SIZE = 1 << 12;  // 4096 entries, must be power of 2
+#else
     static constexpr int SIZE = 1 << 16;  // 65536 entries, must be power of 2
+#endif
     static constexpr int MASK = SIZE - 1;
 
     PawnTable() { std::fill(entries_, entries_ + SIZE, PawnEntry{}); }
 
     PawnEntry* probe(uint64_t pawnKey) { return &entries_[pawnKey & MASK]; }
 
+    // Hint the CPU to load the entry for pawnKey ahead of the probe in evaluate().
+    void prefetch(uint64_t pawnKey) const {
+#ifdef _MSC_VER
+        _mm_prefetch(reinterpret_cast<const char*>(&entries_[pawnKey & MASK]), _MM_HINT_T0);
+#else
+        __builtin_prefetch(&entries_[pawnKey & MASK], 0, 3);
+#endif
+    }
+
 private:
     PawnEntry entries_[SIZE];
 };
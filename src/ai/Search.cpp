@@ -5,7 +5,6 @@
 
 #include <cassert>
 #include <cmath>
-#include <unordered_set>
 
 // Search algorithm: iterative deepening with the following features:
 //   - Negamax + alpha-beta pruning
@@ -39,22 +38,35 @@ void Search::initLMR() {
     lmrInitialized_ = true;
 }
 
+int Search::lmrReduction(int depth, size_t moveIndex) {
+    initLMR();
+    size_t di = static_cast<size_t>(std::clamp(depth, 0, MAX_LMR_DEPTH - 1));
+    size_t mi = std::min(moveIndex, static_cast<size_t>(MAX_LMR_MOVES - 1));
+    return lmrTable_[di][mi];
+}
+
 Search::Search(const Board& board, const SearchConfig& config, TranspositionTable& tt,
-               eval::PawnTable& pt, InfoCallback infoCallback, std::vector<uint64_t> gameHistory)
+               eval::PawnTable& pt, CorrectionHistory& correction, InfoCallback infoCallback,
+               std::vector<uint64_t> gameHistory)
     : board_(board),
       config_(config),
       tt_(tt),
       pawnTable_(pt),
+      correction_(correction),
       infoCallback_(std::move(infoCallback)),
       gameHistory_(std::move(gameHistory)),
+      pondering_(false),
       stopped_(false),
-      nodes_(0) {
+      nodes_(0),
+      trace_(config.trace) {
     initLMR();
 }
 
 // Runs iterative deepening, returning the best move found within time/depth limits.
 Move Search::findBestMove() {
     startTime_ = std::chrono::steady_clock::now();
+    clockStart_ = startTime_;
+    pondering_ = config_.ponderSignal && config_.ponderSignal->load();
     stopped_ = false;
     nodes_ = 0;
     tt_.newSearch();
@@ -63,9 +75,12 @@ Move Search::findBestMove() {
     for (auto& colorTable : history_)
         for (auto& fromRow : colorTable)
             fromRow.fill(0);
+    lastReport_ = startTime_;
     Move bestMove;
 
-    for (int depth = 1; depth <= config_.maxDepth; ++depth) {
+    const int maxDepth = std::min(config_.maxDepth, MAX_SEARCH_DEPTH);
+    for (int depth = 1; depth <= maxDepth; ++depth) {
+        currentDepth_ = depth;
         int alpha = -eval::SCORE_INFINITY;
         int beta = eval::SCORE_INFINITY;
         Move depthBest;
@@ -84,11 +99,14 @@ Move Search::findBestMove() {
         MoveOrder::sort(moves, board_.position(), ttMove);
 
         uint64_t rootHash = board_.position().hash();
+        uint64_t iterationNodes = nodes_;
         for (size_t i = 0; i < moves.size(); ++i) {
-            assert(searchStack_.empty());
-            searchStack_.push_back(rootHash);
+            assert(searchStackSize_ == 0);
+            pushSearchHash(rootHash);
             UndoInfo undo = board_.makeMoveUnchecked(moves[i]);
             ++nodes_;
+            if (trace_)
+                tracePath(0, moves[i], 0);
 
             bool givesCheck = board_.isInCheck();
 
@@ -102,8 +120,8 @@ Move Search::findBestMove() {
             }
 
             board_.unmakeMove(moves[i], undo);
-            searchStack_.pop_back();
-            assert(searchStack_.empty());
+            popSearchHash();
+            assert(searchStackSize_ == 0);
 
             if (stopped_)
                 break;
@@ -121,6 +139,11 @@ Move Search::findBestMove() {
             break;
 
         bestMove = depthBest;
+        if (trace_) {
+            tracePath(0, bestMove, 0);
+            traceNode(0, depth, -eval::SCORE_INFINITY, eval::SCORE_INFINITY, bestScore,
+                      TracePrune::None, iterationNodes, TRACE_ROOT);
+        }
 
         // Store root result in TT
         tt_.store(board_.position().hash(), scoreToTT(bestScore, 0), depth, TTBound::EXACT,
@@ -128,7 +151,8 @@ Move Search::findBestMove() {
 
         // Report search info
         if (infoCallback_) {
-            auto elapsed = std::chrono::steady_clock::now() - startTime_;
+            lastReport_ = std::chrono::steady_clock::now();
+            auto elapsed = lastReport_ - startTime_;
             int timeMs = static_cast<int>(
                 std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
 
@@ -142,7 +166,7 @@ Move Search::findBestMove() {
         }
 
         // Stop early on forced mate
-        if (bestScore >= eval::SCORE_MATE - config_.maxDepth)
+        if (bestScore >= eval::SCORE_MATE - maxDepth)
             break;
     }
 
@@ -156,24 +180,39 @@ int Search::negamax(int depth, int alpha, int beta, int ply, bool inCheck, bool
     assert(ply >= 0);
     assert(ply < MAX_PLY);
 
+    // Every exit except the hand-off to quiescence goes through leave() so that
+    // tracing, when enabled, sees the node's result and why it returned.
+    const int traceAlpha = alpha;
+    const uint64_t traceNodes = nodes_;
+    auto leave = [&](int score, TracePrune prune) {
+        if (trace_)
+            traceNode(ply, depth, traceAlpha, beta, score, prune, traceNodes,
+                      (inCheck ? TRACE_IN_CHECK : 0) | (nullOk ? 0 : TRACE_NULL_MOVE));
+        return score;
+    };
+
     if ((nodes_ & 1023) == 0)
         checkTime();
     if (stopped_)
-        return 0;
+        return leave(0, TracePrune::Stopped);
 
     // Draw detection: 50-move rule and repetition
     if (board_.isDraw() || isRepetition())
-        return eval::SCORE_DRAW;
+        return leave(eval::SCORE_DRAW, TracePrune::Draw);
 
-    if (depth == 0)
+    // The ply limit is left to quiescence, which returns the static evaluation there
+    if (depth == 0 || ply >= MAX_PLY - 1)
         return quiescence(alpha, beta, ply);
 
     // TT probe
     Move ttMove;
+    int rawEval = TTEntry::NO_EVAL;  // static eval, from the TT when an earlier visit stored it
     uint64_t posHash = board_.position().hash();
     TTEntry ttEntry;
-    if (tt_.probe(posHash, ttEntry)) {
+    if (tt_.probe(posHash, ttEntry, depth)) {
         ttMove = ttEntry.bestMove();
+        rawEval = ttEntry.eval;
+        tt_.stats().recordHitDepth(ttEntry.depth, depth);
         if (ttEntry.depth >= depth) {
             bool isPvNode = (beta - alpha > 1);
             if (!isPvNode) {
@@ -181,17 +220,17 @@ int Search::negamax(int depth, int alpha, int beta, int ply, bool inCheck, bool
                 switch (ttEntry.bound()) {
                     case TTBound::EXACT:
                         ++tt_.stats().cutoffs;
-                        return ttScore;
+                        return leave(ttScore, TracePrune::TTCutoff);
                     case TTBound::LOWER:
                         if (ttScore >= beta) {
                             ++tt_.stats().cutoffs;
-                            return ttScore;
+                            return leave(ttScore, TracePrune::TTCutoff);
                         }
                         break;
                     case TTBound::UPPER:
                         if (ttScore <= alpha) {
                             ++tt_.stats().cutoffs;
-                            return ttScore;
+                            return leave(ttScore, TracePrune::TTCutoff);
                         }
                         break;
                     default:
@@ -210,23 +249,25 @@ int Search::negamax(int depth, int alpha, int beta, int ply, bool inCheck, bool
         Square prevEp = board_.enPassantSquare();
         uint64_t prevHash = board_.position().hash();
         board_.makeNullMove();
+        if (trace_)
+            tracePath(ply, Move{}, 0);
         int nullScore =
             -negamax(depth - 1 - NMP_REDUCTION, -beta, -beta + 1, ply + 1, false, false);
         board_.unmakeNullMove(prevEp, prevHash);
 
         if (stopped_)
-            return 0;
+            return leave(0, TracePrune::Stopped);
         if (nullScore >= beta)
-            return beta;
+            return leave(beta, TracePrune::NullMove);
     }
 
     MoveList moves = board_.getLegalMoves();
 
     if (moves.empty()) {
         if (inCheck) {
-            return -(eval::SCORE_MATE - ply);  // Checkmate
+            return leave(-(eval::SCORE_MATE - ply), TracePrune::Terminal);  // Checkmate
         }
-        return eval::SCORE_DRAW;  // Stalemate
+        return leave(eval::SCORE_DRAW, TracePrune::Terminal);  // Stalemate
     }
 
     const Move* killers = killers_[static_cast<size_t>(ply)].data();
@@ -244,14 +285,16 @@ int Search::negamax(int depth, int alpha, int beta, int ply, bool inCheck, bool
 
     for (size_t i = 0; i < moves.size(); ++i) {
         // Push current hash so children can detect repetition back to this node
-        searchStack_.push_back(posHash);
+        pushSearchHash(posHash);
         UndoInfo undo = board_.makeMoveUnchecked(moves[i]);
         ++nodes_;
-        tt_.prefetch(board_.position().hash());  // hide TT latency behind isInCheck()
+        tt_.prefetch(board_.position().hash(), depth - 1);  // hide TT latency behind isInCheck()
 
         bool givesCheck = board_.isInCheck();
 
         int score;
+        if (trace_)
+            tracePath(ply, moves[i], 0);
         if (i == 0) {
             score = -negamax(depth - 1, -beta, -alpha, ply + 1, givesCheck);
         } else {
@@ -273,7 +316,11 @@ int Search::negamax(int depth, int alpha, int beta, int ply, bool inCheck, bool
                 reduction = std::clamp(reduction, 0, depth - 2);
             }
 
+            if (trace_)
+                tracePath(ply, moves[i], reduction);
             score = -negamax(depth - 1 - reduction, -alpha - 1, -alpha, ply + 1, givesCheck);
+            if (trace_)
+                tracePath(ply, moves[i], 0);
 
             // Re-search at full depth if reduced search beat alpha
             if (reduction > 0 && score > alpha)
@@ -285,10 +332,10 @@ int Search::negamax(int depth, int alpha, int beta, int ply, bool inCheck, bool
         }
 
         board_.unmakeMove(moves[i], undo);
-        searchStack_.pop_back();
+        popSearchHash();
 
         if (stopped_)
-            return 0;
+            return leave(0, TracePrune::Stopped);
 
         // Track quiet moves for history update
         if (!moves[i].isCapture() && !moves[i].isPromotion() && quietsCount < MAX_PLY)
@@ -329,10 +376,24 @@ int Search::negamax(int depth, int alpha, int beta, int ply, bool inCheck, bool
         else
             bound = TTBound::UPPER;
 
-        tt_.store(posHash, scoreToTT(bestScore, ply), depth, bound, bestMoveInNode);
+        // Learn the eval error from quiet positions, where the score bounds it usefully
+        bool quietBest = bestMoveInNode.isNull() ||
+                         (!bestMoveInNode.isCapture() && !bestMoveInNode.isPromotion());
+        bool learn = config_.useCorrection && !inCheck && quietBest &&
+                     std::abs(bestScore) < TT_MATE_THRESHOLD;
+        if (learn && rawEval == TTEntry::NO_EVAL)
+            rawEval = eval::evaluate(board_.position(), pawnTable_);
+
+        tt_.store(posHash, scoreToTT(bestScore, ply), depth, bound, bestMoveInNode, rawEval);
+
+        if (learn) {
+            if (bound == TTBound::EXACT || (bound == TTBound::LOWER && bestScore > rawEval) ||
+                (bound == TTBound::UPPER && bestScore < rawEval))
+                correction_.update(board_.position(), depth, rawEval, bestScore);
+        }
     }
 
-    return bestScore;
+    return leave(bestScore, TracePrune::None);
 }
 
 // Only searches captures and promotions so that static evaluation is never
@@ -343,35 +404,52 @@ int Search::quiescence(int alpha, int beta, int ply) {
     assert(ply >= 0);
     assert(ply < MAX_PLY);
 
+    const int traceAlpha = alpha;
+    const uint64_t traceNodes = nodes_;
+    auto leave = [&](int score, TracePrune prune) {
+        if (trace_)
+            traceNode(ply, 0, traceAlpha, beta, score, prune, traceNodes, TRACE_QUIESCENCE);
+        return score;
+    };
+
     if ((nodes_ & 1023) == 0)
         checkTime();
     if (stopped_)
-        return 0;
+        return leave(0, TracePrune::Stopped);
 
     // TT probe
+    int rawEval = TTEntry::NO_EVAL;
     uint64_t posHash = board_.position().hash();
     TTEntry ttEntry;
-    if (tt_.probe(posHash, ttEntry)) {
+    if (tt_.probe(posHash, ttEntry, 0)) {
+        rawEval = ttEntry.eval;
         int ttScore = scoreFromTT(ttEntry.score, ply);
         if (ttEntry.bound() == TTBound::EXACT) {
             ++tt_.stats().cutoffs;
-            return ttScore;
+            return leave(ttScore, TracePrune::TTCutoff);
         }
         if (ttEntry.bound() == TTBound::LOWER && ttScore >= beta) {
             ++tt_.stats().cutoffs;
-            return ttScore;
+            return leave(ttScore, TracePrune::TTCutoff);
         }
         if (ttEntry.bound() == TTBound::UPPER && ttScore <= alpha) {
             ++tt_.stats().cutoffs;
-            return ttScore;
+            return leave(ttScore, TracePrune::TTCutoff);
         }
     }
 
-    int standPat = eval::evaluate(board_.position(), pawnTable_);
+    if (rawEval == TTEntry::NO_EVAL)
+        rawEval = eval::evaluate(board_.position(), pawnTable_);
+    int standPat =
+        config_.useCorrection ? correction_.correct(board_.position(), rawEval) : rawEval;
+
+    // No deeper: the ply-indexed stacks end at MAX_PLY
+    if (ply >= MAX_PLY - 1)
+        return leave(standPat, TracePrune::PlyLimit);
 
     // Stand-pat cutoff: side to move can choose not to capture
     if (standPat >= beta)
-        return beta;
+        return leave(beta, TracePrune::StandPat);
 
     int origAlpha = alpha;
     int bestScore = standPat;
@@ -388,7 +466,7 @@ int Search::quiescence(int alpha, int beta, int ply) {
         (board_.position().pieces(PieceType::Pawn, Color::White) & RANK_BB[RANK_7]) ||
         (board_.position().pieces(PieceType::Pawn, Color::Black) & RANK_BB[RANK_2]);
     if (standPat < alpha - DELTA_MAX_GAIN - (hasPromotingPawn ? DELTA_PROMO_BONUS : 0))
-        return standPat;
+        return leave(standPat, TracePrune::DeltaNode);
 
     if (standPat > alpha)
         alpha = standPat;
@@ -409,12 +487,14 @@ int Search::quiescence(int alpha, int beta, int ply) {
 
         UndoInfo undo = board_.makeMoveUnchecked(captures[i]);
         ++nodes_;
-        tt_.prefetch(board_.position().hash());  // hide TT latency
+        tt_.prefetch(board_.position().hash(), 0);  // hide TT latency
+        if (trace_)
+            tracePath(ply, captures[i], 0);
         int score = -quiescence(-beta, -alpha, ply + 1);
         board_.unmakeMove(captures[i], undo);
 
         if (stopped_)
-            return 0;
+            return leave(0, TracePrune::Stopped);
 
         if (score > bestScore) {
             bestScore = score;
@@ -436,10 +516,10 @@ int Search::quiescence(int alpha, int beta, int ply) {
         else
             bound = TTBound::UPPER;
 
-        tt_.store(posHash, scoreToTT(bestScore, ply), 0, bound, bestMoveInNode);
+        tt_.store(posHash, scoreToTT(bestScore, ply), 0, bound, bestMoveInNode, rawEval);
     }
 
-    return bestScore;
+    return leave(bestScore, TracePrune::None);
 }
 
 // Returns true if the current position is a draw by repetition, looking back
@@ -450,7 +530,7 @@ bool Search::isRepetition() const {
 
     // Count occurrences in current search path (excluding the current node itself).
     // Any match here = 2-fold repetition within the search = treat as draw.
-    int searchSize = static_cast<int>(searchStack_.size());
+    int searchSize = static_cast<int>(searchStackSize_);
     int searchLookback = std::min(searchSize, halfmove);
     for (int i = searchSize - 1; i >= searchSize - searchLookback; --i) {
         if (searchStack_[static_cast<size_t>(i)] == hash)
@@ -478,16 +558,19 @@ bool Search::isRepetition() const {
 }
 
 // Reconstructs the principal variation by following TT best moves, verifying each is legal.
-std::vector<Move> Search::extractPV(int maxLength) {
-    std::vector<Move> pv;
-    std::vector<UndoInfo> undos;
-    std::unordered_set<uint64_t> seen;
-
-    for (int i = 0; i < maxLength; ++i) {
+// Stops at a repeated position, since TT moves can form a cycle.
+PvLine Search::extractPV(int maxLength) {
+    PvLine pv;
+    std::array<UndoInfo, MAX_PLY> undos;
+    std::array<uint64_t, MAX_PLY> seen;
+    int length = std::min(maxLength, MAX_PLY);
+
+    for (int i = 0; i < length; ++i) {
         uint64_t hash = board_.position().hash();
-        if (seen.count(hash))
+        auto seenEnd = seen.begin() + i;
+        if (std::find(seen.begin(), seenEnd, hash) != seenEnd)
             break;
-        seen.insert(hash);
+        seen[static_cast<size_t>(i)] = hash;
 
         TTEntry entry;
         if (!tt_.probe(hash, entry) || entry.bestMove().isNull())
@@ -505,11 +588,10 @@ std::vector<Move> Search::extractPV(int maxLength) {
         if (!found)
             break;
 
+        undos[pv.size()] = board_.makeMoveUnchecked(entry.bestMove());
         pv.push_back(entry.bestMove());
-        undos.push_back(board_.makeMoveUnchecked(entry.bestMove()));
     }
 
-    assert(pv.size() == undos.size());
     for (size_t i = pv.size(); i > 0; --i) {
         board_.unmakeMove(pv[i - 1], undos[i - 1]);
     }
@@ -540,16 +622,72 @@ void Search::storeKiller(int ply, const Move& move) {
     killers_[p][0] = move;
 }
 
-// Sets stopped_ if the time limit or external stop signal has been reached.
+void Search::traceNode(int ply, int depth, int alpha, int beta, int score, TracePrune prune,
+                       uint64_t nodesAtEntry, int flags) {
+    TraceRecord r{};
+    uint64_t subtree = nodes_ - nodesAtEntry + 1;
+    r.subtreeNodes = static_cast<uint32_t>(std::min<uint64_t>(subtree, UINT32_MAX));
+    r.alpha = alpha;
+    r.beta = beta;
+    r.score = score;
+
+    // The root record (ply 0) carries the iteration's best move, stored in slot 0
+    size_t parent = static_cast<size_t>(ply > 0 ? ply - 1 : 0);
+    TTEntry encoded;
+    encoded.setMove(tracePath_[parent]);
+    r.move = encoded.move16;
+
+    r.ply = static_cast<uint8_t>(ply);
+    r.depth = static_cast<int8_t>(std::clamp(depth, 0, 127));
+    r.type = score >= beta    ? TraceNodeType::Cut
+             : score <= alpha ? TraceNodeType::All
+                              : TraceNodeType::PV;
+    r.prune = prune;
+    r.reduction = traceReduction_[parent];
+    r.flags = static_cast<uint8_t>(flags);
+    trace_->record(r);
+}
+
+// Sets stopped_ if the time limit, node limit or external stop signal has been reached.
+// The time limit is not checked while pondering; the clock starts at the ponder hit.
 void Search::checkTime() {
     if (config_.stopSignal && config_.stopSignal->load(std::memory_order_relaxed)) {
         stopped_ = true;
         return;
     }
-    auto elapsed = std::chrono::steady_clock::now() - startTime_;
-    if (elapsed >= config_.searchTime) {
+    if (config_.maxNodes > 0 && nodes_ >= config_.maxNodes) {
+        stopped_ = true;
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (config_.progressInterval.count() > 0 && infoCallback_ &&
+        now - lastReport_ >= config_.progressInterval)
+        reportProgress(now);
+    if (config_.infinite)
+        return;
+    if (pondering_) {
+        if (config_.ponderSignal->load(std::memory_order_relaxed))
+            return;
+        pondering_ = false;
+        clockStart_ = now;
+    }
+    if (now - clockStart_ >= config_.searchTime) {
         stopped_ = true;
     }
 }
 
+// Reports the nodes and time so far of an unfinished iteration, so a long
+// iteration (go infinite runs for hours) is not silent until it completes.
+void Search::reportProgress(std::chrono::steady_clock::time_point now) {
+    lastReport_ = now;
+    SearchInfo info;
+    info.partial = true;
+    info.depth = currentDepth_;
+    info.nodes = nodes_;
+    info.timeMs = static_cast<int>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime_).count());
+    info.hashfull = tt_.hashfull();
+    infoCallback_(info);
+}
+
 }  // namespace cchess
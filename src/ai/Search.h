@@ -1,68 +1,141 @@
 #ifndef CCHESS_SEARCH_H
 #define CCHESS_SEARCH_H
 
+#include "ai/CorrectionHistory.h"
 #include "ai/PawnTable.h"
 #include "ai/SearchConfig.h"
+#include "ai/SearchTrace.h"
 #include "ai/TranspositionTable.h"
 #include "core/Board.h"
 #include "core/Move.h"
 #include "core/MoveList.h"
+#include "utils/InplaceFunction.h"
 
 #include <algorithm>
 #include <array>
+#include <cassert>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <functional>
 #include <vector>
 
 namespace cchess {
 
 constexpr int MAX_PLY = 128;
 
+// Deepest iteration the search runs. Extensions and quiescence can go past the
+// iteration depth; nodes at MAX_PLY - 1 return a static evaluation instead.
+constexpr int MAX_SEARCH_DEPTH = MAX_PLY - 1;
+
+// Fixed-capacity principal variation, so reporting a PV never allocates.
+class PvLine {
+public:
+    using value_type = Move;
+    PvLine() : size_(0) {}
+
+    void push_back(const Move& move) {
+        assert(size_ < moves_.size());
+        moves_[size_++] = move;
+    }
+    void clear() { size_ = 0; }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    const Move& operator[](size_t i) const { return moves_[i]; }
+
+    const Move* begin() const { return moves_.data(); }
+    const Move* end() const { return moves_.data() + size_; }
+
+private:
+    std::array<Move, MAX_PLY> moves_;
+    size_t size_;
+};
+
 struct SearchInfo {
     int depth = 0;
     int score = 0;
     uint64_t nodes = 0;
     int timeMs = 0;
-    std::vector<Move> pv;
+    PvLine pv;
+
+    // A progress report from inside an iteration (SearchConfig::progressInterval):
+    // depth is the unfinished iteration, and score and pv are not set.
+    bool partial = false;
+    int hashfull = -1;  // permille of the TT used by this search; -1 when not reported
 };
 
-using InfoCallback = std::function<void(const SearchInfo&)>;
+// Stored inline: capture state by reference to keep the callable small.
+using InfoCallback = InplaceFunction<void(const SearchInfo&)>;
 
 class Search {
 public:
     Search(const Board& board, const SearchConfig& config, TranspositionTable& tt,
-           eval::PawnTable& pt, InfoCallback infoCallback = nullptr,
-           std::vector<uint64_t> gameHistory = {});
+           eval::PawnTable& pt, CorrectionHistory& correction,
+           InfoCallback infoCallback = nullptr, std::vector<uint64_t> gameHistory = {});
 
     Move findBestMove();
 
     uint64_t totalNodes() const { return nodes_; }
 
+    // Late-move reduction for a quiet move at the given depth and move index, before the
+    // history adjustment. Shared with the interleaved search so both reduce identically.
+    static int lmrReduction(int depth, size_t moveIndex);
+
 private:
     int negamax(int depth, int alpha, int beta, int ply, bool inCheck, bool nullOk = true);
     int quiescence(int alpha, int beta, int ply);
     void checkTime();
-    std::vector<Move> extractPV(int maxLength);
+    void reportProgress(std::chrono::steady_clock::time_point now);
+    PvLine extractPV(int maxLength);
 
     bool isRepetition() const;
 
+    // Tracing (opt-in via SearchConfig::trace). The parent notes the move and LMR
+    // reduction leading to each child before searching it; the child records itself
+    // on return. traceNode is cold and out of line so the untraced path stays a branch.
+    void tracePath(int ply, const Move& move, int reduction) {
+        tracePath_[static_cast<size_t>(ply)] = move;
+        traceReduction_[static_cast<size_t>(ply)] = static_cast<uint8_t>(reduction);
+    }
+    [[gnu::cold]] void traceNode(int ply, int depth, int alpha, int beta, int score,
+                                 TracePrune prune, uint64_t nodesAtEntry, int flags);
+
     Board board_;
     SearchConfig config_;
     TranspositionTable& tt_;
     eval::PawnTable& pawnTable_;
+    CorrectionHistory& correction_;  // learned static-eval error, applied to stand-pat
     InfoCallback infoCallback_;
 
     // Positions are stored in two separate containers because the draw threshold differs:
     // any repetition within the current search path is treated as an immediate draw
     // (preventing the engine from chasing a repetition it could avoid), while game
     // history requires the standard three-fold repetition before scoring as a draw.
+    // The search path is a fixed stack indexed by ply, so the search never allocates.
     std::vector<uint64_t> gameHistory_;
-    std::vector<uint64_t> searchStack_;
+    std::array<uint64_t, MAX_PLY> searchStack_{};
+    size_t searchStackSize_ = 0;
+    void pushSearchHash(uint64_t hash) {
+        assert(searchStackSize_ < searchStack_.size());
+        searchStack_[searchStackSize_++] = hash;
+    }
+    void popSearchHash() {
+        assert(searchStackSize_ > 0);
+        --searchStackSize_;
+    }
 
     std::chrono::steady_clock::time_point startTime_;
+    std::chrono::steady_clock::time_point clockStart_;  // time limit origin; moves on ponder hit
+    bool pondering_;
     bool stopped_;
     uint64_t nodes_;
+    int currentDepth_ = 0;                               // iteration being searched
+    std::chrono::steady_clock::time_point lastReport_;  // last info sent, for progressInterval
+
+    SearchTrace* trace_;
+    std::array<Move, MAX_PLY> tracePath_{};
+    std::array<uint8_t, MAX_PLY> traceReduction_{};
 
     // Two quiet moves per ply that recently caused a beta-cutoff.
     // Tried early in sibling nodes — a refutation at one branch often works in
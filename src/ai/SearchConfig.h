@@ -3,13 +3,35 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 
 namespace cchess {
 
+class SearchTrace;
+
 struct SearchConfig {
     std::chrono::milliseconds searchTime{1000};
     int maxDepth{64};
+    uint64_t maxNodes{0};                     // 0 = no node limit
     std::atomic<bool>* stopSignal = nullptr;  // external stop (for UCI "stop")
+
+    // No time limit: the search runs until *stopSignal, maxNodes or maxDepth (for
+    // UCI "go infinite", with maxDepth = MAX_SEARCH_DEPTH).
+    bool infinite = false;
+
+    // When nonzero, a partial SearchInfo is reported this often from inside an
+    // iteration, so iterations that take minutes still show progress.
+    std::chrono::milliseconds progressInterval{0};
+
+    // While *ponderSignal is true the time limit is suspended; clearing it (a ponder
+    // hit) starts the clock, so the search gets its full budget from that moment.
+    std::atomic<bool>* ponderSignal = nullptr;
+
+    // Apply and learn correction history (see CorrectionHistory.h); off only to
+    // measure what it is worth (cchess --bench-correction).
+    bool useCorrection = true;
+
+    SearchTrace* trace = nullptr;  // records every node when set (see SearchTrace.h)
 };
 
 }  // namespace cchess
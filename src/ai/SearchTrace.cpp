@@ -0,0 +1,200 @@
+#include "ai/SearchTrace.h"
+
+#include "ai/TranspositionTable.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+
+namespace cchess {
+
+namespace {
+
+constexpr char TRACE_MAGIC[8] = {'C', 'C', 'T', 'R', 'A', 'C', 'E', '1'};
+
+struct TraceFileHeader {
+    char magic[8];
+    uint32_t recordSize;
+    uint32_t reserved;
+    uint64_t totalRecorded;
+    uint64_t count;
+};
+
+std::string moveName(uint16_t move16) {
+    TTEntry entry;
+    entry.move16 = move16;
+    Move m = entry.bestMove();
+    return m.isNull() ? "(none)" : m.toAlgebraic();
+}
+
+}  // namespace
+
+SearchTrace::SearchTrace(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity)
+        size <<= 1;
+    buffer_ = std::make_unique<TraceRecord[]>(size);
+    mask_ = size - 1;
+}
+
+std::vector<TraceRecord> SearchTrace::snapshot() const {
+    uint64_t head = recorded();
+    uint64_t count = std::min<uint64_t>(head, capacity());
+    std::vector<TraceRecord> records;
+    records.reserve(count);
+    for (uint64_t i = head - count; i < head; ++i)
+        records.push_back(buffer_[i & mask_]);
+    return records;
+}
+
+bool SearchTrace::writeTo(const std::string& path) const {
+    std::vector<TraceRecord> records = snapshot();
+
+    TraceFileHeader header{};
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.recordSize = sizeof(TraceRecord);
+    header.totalRecorded = recorded();
+    header.count = records.size();
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(records.data()),
+               static_cast<std::streamsize>(records.size() * sizeof(TraceRecord)));
+    return file.good();
+}
+
+std::optional<std::vector<TraceRecord>> SearchTrace::readFrom(const std::string& path,
+                                                              uint64_t* totalRecorded) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return std::nullopt;
+
+    TraceFileHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0 ||
+        header.recordSize != sizeof(TraceRecord))
+        return std::nullopt;
+
+    std::vector<TraceRecord> records(header.count);
+    if (!file.read(reinterpret_cast<char*>(records.data()),
+                   static_cast<std::streamsize>(records.size() * sizeof(TraceRecord))))
+        return std::nullopt;
+
+    if (totalRecorded)
+        *totalRecorded = header.totalRecorded;
+    return records;
+}
+
+const char* SearchTrace::pruneName(TracePrune prune) {
+    switch (prune) {
+        case TracePrune::None:
+            return "none";
+        case TracePrune::Draw:
+            return "draw";
+        case TracePrune::TTCutoff:
+            return "tt-cutoff";
+        case TracePrune::NullMove:
+            return "null-move";
+        case TracePrune::Terminal:
+            return "terminal";
+        case TracePrune::StandPat:
+            return "stand-pat";
+        case TracePrune::DeltaNode:
+            return "delta";
+        case TracePrune::Stopped:
+            return "stopped";
+        case TracePrune::PlyLimit:
+            return "ply-limit";
+        default:
+            return "unknown";
+    }
+}
+
+void SearchTrace::summarize(const std::vector<TraceRecord>& records, std::ostream& out) {
+    constexpr size_t PRUNE_COUNT = static_cast<size_t>(TracePrune::Count);
+    // Per reason: the nodes that ended that way, and the subtree nodes under them
+    std::array<uint64_t, PRUNE_COUNT> mainByPrune{};
+    std::array<uint64_t, PRUNE_COUNT> qsByPrune{};
+    std::array<uint64_t, PRUNE_COUNT> mainSubtree{};
+    std::array<uint64_t, PRUNE_COUNT> qsSubtree{};
+    std::array<uint64_t, 3> byType{};
+    uint64_t reduced = 0;
+
+    for (const auto& r : records) {
+        if (r.flags & TRACE_ROOT)
+            continue;
+        auto prune = static_cast<size_t>(r.prune);
+        bool qs = r.flags & TRACE_QUIESCENCE;
+        if (prune < PRUNE_COUNT) {
+            ++(qs ? qsByPrune : mainByPrune)[prune];
+            (qs ? qsSubtree : mainSubtree)[prune] += r.subtreeNodes;
+        }
+        auto type = static_cast<size_t>(r.type);
+        if (type < byType.size())
+            ++byType[type];
+        if (r.reduction > 0)
+            ++reduced;
+    }
+
+    out << "Records: " << records.size() << "\n\n";
+    out << "Nodes ending with each reason, and the subtree nodes summed over them\n"
+        << "(nested subtrees are counted once per enclosing node):\n";
+    out << std::left << std::setw(12) << "prune" << std::right << std::setw(14) << "main nodes"
+        << std::setw(16) << "main subtree" << std::setw(14) << "qs nodes" << std::setw(16)
+        << "qs subtree" << "\n";
+    for (size_t p = 0; p < PRUNE_COUNT; ++p) {
+        out << std::left << std::setw(12) << pruneName(static_cast<TracePrune>(p)) << std::right
+            << std::setw(14) << mainByPrune[p] << std::setw(16) << mainSubtree[p]
+            << std::setw(14) << qsByPrune[p] << std::setw(16) << qsSubtree[p] << "\n";
+    }
+    out << "\nNode types: PV " << byType[0] << ", cut " << byType[1] << ", all " << byType[2]
+        << "; LMR-reduced " << reduced << "\n";
+
+    // Root moves of the last completed iteration: its ply-1 records directly
+    // precede its root record. Without a root record (buffer wrapped mid-iteration)
+    // use every ply-1 record held.
+    auto lastRoot = std::find_if(records.rbegin(), records.rend(),
+                                 [](const TraceRecord& r) { return r.flags & TRACE_ROOT; });
+    size_t end = records.size();
+    size_t begin = 0;
+    int depth = -1;
+    if (lastRoot != records.rend()) {
+        end = static_cast<size_t>(records.rend() - lastRoot) - 1;
+        depth = lastRoot->depth;
+        auto prevRoot = std::find_if(lastRoot + 1, records.rend(),
+                                     [](const TraceRecord& r) { return r.flags & TRACE_ROOT; });
+        begin = static_cast<size_t>(records.rend() - prevRoot);
+    }
+
+    std::map<uint16_t, uint64_t> byMove;
+    uint64_t iterationNodes = 0;
+    for (size_t i = begin; i < end; ++i) {
+        if (records[i].ply == 1 && !(records[i].flags & TRACE_ROOT)) {
+            byMove[records[i].move] += records[i].subtreeNodes;
+            iterationNodes += records[i].subtreeNodes;
+        }
+    }
+
+    std::vector<std::pair<uint16_t, uint64_t>> moves(byMove.begin(), byMove.end());
+    std::sort(moves.begin(), moves.end(),
+              [](const auto& a, const auto& b) { return a.second > b.second; });
+
+    out << "\nSubtree nodes by root move";
+    if (depth >= 0)
+        out << " (iteration depth " << depth << ")";
+    out << ":\n";
+    for (const auto& [move, nodes] : moves) {
+        double share = iterationNodes > 0 ? 100.0 * static_cast<double>(nodes) /
+                                                static_cast<double>(iterationNodes)
+                                          : 0.0;
+        out << "  " << std::left << std::setw(8) << moveName(move) << std::right << std::setw(12)
+            << nodes << std::fixed << std::setprecision(1) << std::setw(8) << share << "%\n";
+    }
+}
+
+}  // namespace cchess
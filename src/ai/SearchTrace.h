@@ -0,0 +1,113 @@
+#ifndef CCHESS_SEARCH_TRACE_H
+#define CCHESS_SEARCH_TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace cchess {
+
+// Result class of a traced node, from its score against the window it was given.
+enum class TraceNodeType : uint8_t {
+    PV = 0,   // alpha < score < beta
+    Cut = 1,  // score >= beta
+    All = 2   // score <= alpha
+};
+
+// Why a node returned before (or without) searching its moves.
+enum class TracePrune : uint8_t {
+    None = 0,       // searched normally
+    Draw = 1,       // 50-move rule or repetition
+    TTCutoff = 2,   // TT entry was deep enough
+    NullMove = 3,   // null move search failed high
+    Terminal = 4,   // checkmate or stalemate
+    StandPat = 5,   // quiescence stand-pat >= beta
+    DeltaNode = 6,  // quiescence: no capture can reach alpha
+    Stopped = 7,    // time, node limit or stop signal
+    PlyLimit = 8,   // MAX_PLY reached: static evaluation
+    Count
+};
+
+// Trace record flags
+constexpr uint8_t TRACE_QUIESCENCE = 1 << 0;
+constexpr uint8_t TRACE_IN_CHECK = 1 << 1;
+constexpr uint8_t TRACE_NULL_MOVE = 1 << 2;  // reached through a null move
+constexpr uint8_t TRACE_ROOT = 1 << 3;       // iteration summary for the root
+
+// One node, written when the node returns. Records are in post-order, so a
+// node's subtree precedes it. Scores and the window are from the side to move.
+struct TraceRecord {
+    uint32_t subtreeNodes;  // nodes in this subtree, including the node (saturates)
+    int32_t alpha;          // window at entry
+    int32_t beta;
+    int32_t score;
+    uint16_t move;  // move into this node, TTEntry::move16 encoding (best move for roots)
+    uint8_t ply;
+    int8_t depth;  // remaining depth at entry; 0 in quiescence
+    TraceNodeType type;
+    TracePrune prune;
+    uint8_t reduction;  // LMR plies the parent took off this node
+    uint8_t flags;      // TRACE_* bits
+};
+
+static_assert(sizeof(TraceRecord) == 24, "TraceRecord must stay 24 bytes");
+
+// Ring buffer of trace records for one search thread.
+//
+// Tracing is opt-in: Search records only when SearchConfig::trace points to a
+// buffer, so with tracing off each node pays just one predictable branch. A
+// buffer has a single writer (its search thread) and never blocks or
+// allocates. When full it overwrites the oldest records, so it always holds
+// the most recent capacity() nodes.
+//
+// File format (native byte order): the 8-byte magic "CCTRACE1", then uint32
+// record size, uint32 reserved, uint64 total records written (including
+// overwritten ones), uint64 records in the file, then the records, oldest first.
+class SearchTrace {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = size_t{1} << 20;  // 24 MB
+
+    explicit SearchTrace(size_t capacity = DEFAULT_CAPACITY);  // rounded up to a power of 2
+
+    void record(const TraceRecord& r) {
+        uint64_t h = head_.load(std::memory_order_relaxed);
+        buffer_[h & mask_] = r;
+        head_.store(h + 1, std::memory_order_release);
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+    uint64_t recorded() const { return head_.load(std::memory_order_acquire); }
+    void clear() { head_.store(0, std::memory_order_release); }
+
+    // Records currently held, oldest first. Take it once the search has finished;
+    // a snapshot of a running search may contain a few overwritten records.
+    std::vector<TraceRecord> snapshot() const;
+
+    // Writes the snapshot to path. Returns false if the file cannot be written.
+    bool writeTo(const std::string& path) const;
+
+    // Reads a trace file. Returns nullopt if it is missing or malformed.
+    static std::optional<std::vector<TraceRecord>> readFrom(const std::string& path,
+                                                            uint64_t* totalRecorded = nullptr);
+
+    // Prints, per pruning reason, the number of nodes that ended that way and
+    // the sum of their subtree sizes; node counts by node type; and subtree
+    // sizes by root move for the deepest traced iteration.
+    static void summarize(const std::vector<TraceRecord>& records, std::ostream& out);
+
+    static const char* pruneName(TracePrune prune);
+
+private:
+    std::unique_ptr<TraceRecord[]> buffer_;
+    size_t mask_;
+    std::atomic<uint64_t> head_{0};
+};
+
+}  // namespace cchess
+
+#endif  // CCHESS_SEARCH_TRACE_H
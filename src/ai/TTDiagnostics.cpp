@@ -0,0 +1,71 @@
+#include "ai/TTDiagnostics.h"
+
+#include <iomanip>
+#include <numeric>
+#include <string>
+
+namespace cchess {
+
+namespace {
+
+double percent(uint64_t part, uint64_t whole) {
+    return whole ? 100.0 * static_cast<double>(part) / static_cast<double>(whole) : 0.0;
+}
+
+}  // namespace
+
+void TTDiagnostics::print(std::ostream& out) const {
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(1);
+
+    uint64_t used = usedSlots();
+    out << "TT diagnostics: sampled " << sampledClusters << " of " << clusterCount
+        << " clusters, " << used << "/" << sampledSlots() << " slots used ("
+        << percent(used, sampledSlots()) << "%)\n";
+
+    out << "  bound:  exact " << percent(bound[static_cast<size_t>(TTBound::EXACT)], used)
+        << "%  lower " << percent(bound[static_cast<size_t>(TTBound::LOWER)], used) << "%  upper "
+        << percent(bound[static_cast<size_t>(TTBound::UPPER)], used) << "%\n";
+
+    // Depth 0 entries are quiescence results
+    out << "  stored depth (% of used):\n   ";
+    for (int d = 0; d < DEPTH_BUCKETS; ++d) {
+        uint64_t n = depth[static_cast<size_t>(d)];
+        if (n == 0)
+            continue;
+        out << " " << d << (d == DEPTH_BUCKETS - 1 ? "+" : "") << ":" << percent(n, used);
+    }
+    out << "\n";
+
+    out << "  age in searches, per cluster slot (% of slot):\n";
+    for (size_t slot = 0; slot < SLOTS; ++slot) {
+        uint64_t slotUsed = std::accumulate(age[slot].begin(), age[slot].end(), uint64_t{0});
+        out << "    slot " << slot << ":";
+        for (int a = 0; a < AGE_BUCKETS; ++a) {
+            out << " " << a << (a == AGE_BUCKETS - 1 ? "+" : "") << ":"
+                << percent(age[slot][static_cast<size_t>(a)], slotUsed);
+        }
+        out << "\n";
+    }
+
+    uint64_t hits = std::accumulate(hitDepthMargin.begin(), hitDepthMargin.end(), uint64_t{0});
+    out << "  hit depth - requested depth (main search, " << hits << " hits):\n   ";
+    for (size_t i = 0; i < hitDepthMargin.size(); ++i) {
+        int margin = static_cast<int>(i) - TTStats::HIT_MARGIN_RANGE;
+        std::string label = std::to_string(margin);
+        if (margin > 0)
+            label = "+" + label;
+        if (margin == -TTStats::HIT_MARGIN_RANGE)
+            label = "<=" + label;
+        else if (margin == TTStats::HIT_MARGIN_RANGE)
+            label = ">=" + label;
+        out << " " << label << ":" << percent(hitDepthMargin[i], hits);
+    }
+    out << "\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+}  // namespace cchess
@@ -0,0 +1,40 @@
+#ifndef CCHESS_TT_DIAGNOSTICS_H
+#define CCHESS_TT_DIAGNOSTICS_H
+
+#include "ai/TranspositionTable.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace cchess {
+
+// What the transposition table holds, from a sample of its clusters, plus how
+// deep the entries the search hit were compared with the depth it asked for.
+//
+// Sampling reads a few thousand evenly spaced clusters instead of the whole
+// table, so a dump costs microseconds even on a multi-gigabyte table and can
+// be taken between moves (or, approximately, while a search runs).
+struct TTDiagnostics {
+    static constexpr int DEPTH_BUCKETS = 32;  // last bucket: that depth or deeper
+    static constexpr int AGE_BUCKETS = 8;     // searches since stored; last: 7+
+    static constexpr size_t SLOTS = 4;        // entries per cluster
+
+    size_t sampledClusters = 0;
+    size_t clusterCount = 0;
+    uint64_t emptySlots = 0;
+    std::array<uint64_t, DEPTH_BUCKETS> depth{};
+    std::array<uint64_t, 4> bound{};                              // indexed by TTBound
+    std::array<std::array<uint64_t, AGE_BUCKETS>, SLOTS> age{};  // [slot][age]
+    TTStats::HitDepthHistogram hitDepthMargin{};                  // copied from TTStats
+
+    uint64_t sampledSlots() const { return sampledClusters * SLOTS; }
+    uint64_t usedSlots() const { return sampledSlots() - emptySlots; }
+
+    void print(std::ostream& out) const;
+};
+
+}  // namespace cchess
+
+#endif  // CCHESS_TT_DIAGNOSTICS_H
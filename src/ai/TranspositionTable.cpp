@@ -1,5 +1,9 @@
 #include "ai/TranspositionTable.h"
 
+#include "ai/TTDiagnostics.h"
+#include "utils/Affinity.h"
+#include "utils/CpuFeatures.h"
+
 #include <algorithm>
 #include <cassert>
 #include <climits>
@@ -7,24 +11,59 @@
 namespace cchess {
 
 TranspositionTable::TranspositionTable(size_t sizeMB) {
+    resize(sizeMB);
+}
+
+void TranspositionTable::resize(size_t sizeMB) {
     size_t numClusters = (sizeMB * 1024 * 1024) / sizeof(TTCluster);
     // Round down to power of 2
     size_t pot = 1;
     while (pot * 2 <= numClusters)
         pot *= 2;
-    clusters_.resize(pot);
+    std::vector<TTCluster>(pot).swap(clusters_);  // releases the old table
     mask_ = pot - 1;
+    std::fill(hotClusters_.begin(), hotClusters_.end(), TTCluster{});
+    generation_ = 0;
+    stats_.reset();
+}
+
+void TranspositionTable::setHotTable(size_t sizeKB) {
+    size_t numClusters = (sizeKB * 1024) / sizeof(TTCluster);
+    size_t pot = 0;
+    if (numClusters > 0) {
+        pot = 1;
+        while (pot * 2 <= numClusters)
+            pot *= 2;
+    }
+    std::vector<TTCluster>(pot).swap(hotClusters_);
+    hotMask_ = pot > 0 ? pot - 1 : 0;
+}
+
+size_t TranspositionTable::defaultHotTableKB() {
+    size_t l2KB = l2CacheBytes() / 1024;
+    if (l2KB == 0)
+        return 256;
+    return std::clamp<size_t>(l2KB / 2, 64, 1024);
 }
 
 void TranspositionTable::store(uint64_t hash, int score, int depth, TTBound bound,
-                               const Move& bestMove) {
+                               const Move& bestMove, int eval) {
     assert(bound != TTBound::NONE);
-    assert(depth >= 0);
+    assert(depth >= 0 && depth <= INT8_MAX);
     ++stats_.stores;
 
-    uint16_t key16 = verifyKey(hash);
-    TTCluster& cluster = clusters_[clusterIndex(hash)];
+    if (isHot(depth)) {
+        ++stats_.hotStores;
+        storeInCluster(hotClusters_[hotIndex(hash)], verifyKey(hash), score, depth, bound,
+                       bestMove, eval);
+    } else {
+        storeInCluster(clusters_[clusterIndex(hash)], verifyKey(hash), score, depth, bound,
+                       bestMove, eval);
+    }
+}
 
+void TranspositionTable::storeInCluster(TTCluster& cluster, uint16_t key16, int score, int depth,
+                                        TTBound bound, const Move& bestMove, int eval) {
     // Find the best slot to replace:
     // 1. Same position (update in place) — prefer this always
     // 2. Empty slot
@@ -37,8 +76,11 @@ void TranspositionTable::store(uint64_t hash, int score, int depth, TTBound boun
 
         // Same position: update if new depth >= old, or new bound is EXACT
         if (!e.isEmpty() && e.hashVerify == key16) {
-            if (depth < e.depth && bound != TTBound::EXACT)
+            if (depth < e.depth && bound != TTBound::EXACT) {
+                if (e.eval == TTEntry::NO_EVAL)
+                    e.eval = static_cast<int16_t>(eval);
                 return;
+            }
             replace = &e;
             break;
         }
@@ -67,17 +109,25 @@ void TranspositionTable::store(uint64_t hash, int score, int depth, TTBound boun
 
     replace->hashVerify = key16;
     replace->score = static_cast<int16_t>(score);
-    replace->depth = static_cast<int16_t>(depth);
+    replace->eval = static_cast<int16_t>(eval);
+    replace->depth = static_cast<int8_t>(depth);
     replace->genBound = static_cast<uint8_t>((generation_ << 2) | static_cast<uint8_t>(bound));
     replace->setMove(bestMove);
 }
 
+bool TranspositionTable::bindToNode(int node) {
+    if (!hotClusters_.empty())
+        bindMemoryToNode(hotClusters_.data(), hotClusters_.size() * sizeof(TTCluster), node);
+    return bindMemoryToNode(clusters_.data(), clusters_.size() * sizeof(TTCluster), node);
+}
+
 void TranspositionTable::newSearch() {
     generation_ = (generation_ + 1) & 0x3F;  // wrap at 64 (6 bits)
 }
 
 void TranspositionTable::clear() {
     std::fill(clusters_.begin(), clusters_.end(), TTCluster{});
+    std::fill(hotClusters_.begin(), hotClusters_.end(), TTCluster{});
     generation_ = 0;
     stats_.reset();
 }
@@ -91,4 +141,41 @@ size_t TranspositionTable::usedEntries() const {
     return count;
 }
 
+int TranspositionTable::hashfull() const {
+    size_t clusters = std::min<size_t>(250, clusterCount());
+    int used = 0;
+    for (size_t c = 0; c < clusters; ++c)
+        for (const TTEntry& e : clusters_[c].entries)
+            if (!e.isEmpty() && e.generation() == generation_)
+                ++used;
+    return used * 1000 / static_cast<int>(clusters * 4);
+}
+
+TTDiagnostics TranspositionTable::sample(size_t maxClusters) const {
+    TTDiagnostics d;
+    d.clusterCount = clusterCount();
+    d.hitDepthMargin = stats_.hitDepthMargin;
+
+    size_t samples = std::clamp<size_t>(maxClusters, 1, clusterCount());
+    size_t step = clusterCount() / samples;
+    for (size_t s = 0; s < samples; ++s) {
+        const TTCluster& cluster = clusters_[s * step];
+        for (size_t slot = 0; slot < TTDiagnostics::SLOTS; ++slot) {
+            const TTEntry& e = cluster.entries[slot];
+            if (e.isEmpty()) {
+                ++d.emptySlots;
+                continue;
+            }
+            int depth = std::min<int>(e.depth, TTDiagnostics::DEPTH_BUCKETS - 1);
+            ++d.depth[static_cast<size_t>(depth)];
+            ++d.bound[static_cast<size_t>(e.bound())];
+            int age = (generation_ - e.generation()) & 0x3F;
+            age = std::min(age, TTDiagnostics::AGE_BUCKETS - 1);
+            ++d.age[slot][static_cast<size_t>(age)];
+        }
+    }
+    d.sampledClusters = samples;
+    return d;
+}
+
 }  // namespace cchess
@@ -4,7 +4,10 @@
 #include "core/Move.h"
 #include "core/Types.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -23,9 +26,9 @@ enum class TTBound : uint8_t { NONE = 0, EXACT = 1, LOWER = 2, UPPER = 3 };
 //   uint16_t hashVerify  — upper 16 bits of Zobrist key
 //   int16_t  score       — search score (fits in int16_t for chess)
 //   uint16_t move16      — encoded move: from(6)|to(6)|type(3)|promo(1)
-//   int16_t  depth       — search depth (int16_t avoids depth-limit and padding)
+//   int16_t  eval        — raw static eval of the position, NO_EVAL if not computed
+//   int8_t   depth       — search depth (at most MAX_SEARCH_DEPTH)
 //   uint8_t  genBound    — generation(6) | bound(2)
-//   uint8_t  _pad        — explicit pad byte to reach 10 bytes
 // Total: 2+2+2+2+1+1 = 10 bytes, static_assert enforced.
 //
 // Move encoding in 16 bits:
@@ -39,12 +42,14 @@ enum class TTBound : uint8_t { NONE = 0, EXACT = 1, LOWER = 2, UPPER = 3 };
 //                   7=Rook+PromoCapture
 //     Values 4-11 cover all promotion variants; 0-3 cover non-promotion types.
 struct TTEntry {
+    static constexpr int NO_EVAL = INT16_MIN;
+
     uint16_t hashVerify = 0;
     int16_t score = 0;
     uint16_t move16 = 0;
-    int16_t depth = 0;
+    int16_t eval = NO_EVAL;  // uncorrected, so it stays valid as correction history learns
+    int8_t depth = 0;
     uint8_t genBound = 0;  // generation(6) | bound(2)
-    uint8_t _pad = 0;      // explicit padding to reach 10 bytes
 
     TTBound bound() const { return static_cast<TTBound>(genBound & 0x3); }
     uint8_t generation() const { return genBound >> 2; }
@@ -115,19 +120,41 @@ struct alignas(64) TTCluster {
 static_assert(sizeof(TTCluster) == 64, "TTCluster must be exactly 64 bytes (one cache line)");
 
 struct TTStats {
+    // Stored depth minus requested depth for main-search hits, clamped to
+    // [-HIT_MARGIN_RANGE, +HIT_MARGIN_RANGE]; index 0 is the most negative margin.
+    static constexpr int HIT_MARGIN_RANGE = 8;
+    using HitDepthHistogram = std::array<uint64_t, 2 * HIT_MARGIN_RANGE + 1>;
+
     uint64_t probes = 0;
     uint64_t hits = 0;
     uint64_t cutoffs = 0;  // hit with sufficient depth
     uint64_t stores = 0;
     uint64_t overwrites = 0;  // replaced a non-empty slot
+    uint64_t hotProbes = 0;   // lookups in the hot table (included in probes)
+    uint64_t hotHits = 0;     // hits found there (included in hits)
+    uint64_t hotStores = 0;   // stores that went there (included in stores)
+    HitDepthHistogram hitDepthMargin{};
 
-    void reset() { probes = hits = cutoffs = stores = overwrites = 0; }
+    void recordHitDepth(int storedDepth, int requestedDepth) {
+        int margin = std::clamp(storedDepth - requestedDepth, -HIT_MARGIN_RANGE, HIT_MARGIN_RANGE);
+        ++hitDepthMargin[static_cast<size_t>(margin + HIT_MARGIN_RANGE)];
+    }
+
+    void reset() {
+        probes = hits = cutoffs = stores = overwrites = 0;
+        hotProbes = hotHits = hotStores = 0;
+        hitDepthMargin.fill(0);
+    }
     double hitRate() const {
         return probes ? 100.0 * static_cast<double>(hits) / static_cast<double>(probes) : 0.0;
     }
     double cutoffRate() const {
         return probes ? 100.0 * static_cast<double>(cutoffs) / static_cast<double>(probes) : 0.0;
     }
+    double hotHitRate() const {
+        return hotProbes ? 100.0 * static_cast<double>(hotHits) / static_cast<double>(hotProbes)
+                         : 0.0;
+    }
 };
 
 // Mate scores are stored relative to root, not ply. Convert before storing
@@ -151,27 +178,54 @@ inline int scoreFromTT(int score, int ply) {
     return score;
 }
 
+struct TTDiagnostics;
+
+// Optionally two-level: with a hot table (setHotTable), results of depth <=
+// HOT_MAX_DEPTH — quiescence entries and the shallowest main-search nodes, by
+// far the most numerous — are stored in a small table sized to stay in L2, and
+// the main table keeps only deeper results. Probes and prefetches that pass
+// the node's depth follow the same split: shallow nodes look only in the hot
+// table, so they never wait on DRAM, and deep nodes look in the main table and
+// then, on a miss, in the hot one for a hash move.
 class TranspositionTable {
 public:
-    explicit TranspositionTable(size_t sizeMB = 512);
+    static constexpr size_t DEFAULT_DIAGNOSTIC_SAMPLE = 4096;
+    static constexpr int HOT_MAX_DEPTH = 1;
+    static constexpr int DEEP = 1 << 14;  // probe/prefetch depth of callers with no node depth
+    // DEFAULT_WORKER_SIZE_MB: per worker, for the modes that run one table per thread
+#ifdef CCHESS_LOW_MEMORY
+    static constexpr size_t DEFAULT_SIZE_MB = 16;
+    static constexpr size_t DEFAULT_WORKER_SIZE_MB = 16;
+#else
+    static constexpr size_t DEFAULT_SIZE_MB = 512;
+    static constexpr size_t DEFAULT_WORKER_SIZE_MB = 64;
+#endif
 
-    inline bool probe(uint64_t hash, TTEntry& out) {
+    explicit TranspositionTable(size_t sizeMB = DEFAULT_SIZE_MB);
+
+    // depth: the remaining depth of the probing node (0 in quiescence)
+    inline bool probe(uint64_t hash, TTEntry& out, int depth = DEEP) {
         ++stats_.probes;
         uint16_t key16 = verifyKey(hash);
-        const TTCluster& cluster = clusters_[clusterIndex(hash)];
-        for (int i = 0; i < 4; ++i) {
-            const TTEntry& e = cluster.entries[i];
-            if (e.hashVerify == key16 && !e.isEmpty()) {
-                out = e;
-                ++stats_.hits;
-                return true;
-            }
+        bool shallow = isHot(depth);
+        if (!shallow && findEntry(clusters_[clusterIndex(hash)], key16, out)) {
+            ++stats_.hits;
+            return true;
+        }
+        if (hotClusters_.empty())
+            return false;
+        ++stats_.hotProbes;
+        if (findEntry(hotClusters_[hotIndex(hash)], key16, out)) {
+            ++stats_.hits;
+            ++stats_.hotHits;
+            return true;
         }
         return false;
     }
 
-    inline void prefetch(uint64_t hash) const {
-        const void* addr = &clusters_[clusterIndex(hash)];
+    inline void prefetch(uint64_t hash, int depth = DEEP) const {
+        const void* addr = isHot(depth) ? &hotClusters_[hotIndex(hash)]
+                                        : &clusters_[clusterIndex(hash)];
 #ifdef _MSC_VER
         _mm_prefetch(static_cast<const char*>(addr), _MM_HINT_T0);
 #else
@@ -179,10 +233,29 @@ public:
 #endif
     }
 
-    void store(uint64_t hash, int score, int depth, TTBound bound, const Move& bestMove);
+    // eval: the node's raw static eval, kept for later visits; NO_EVAL when not computed
+    void store(uint64_t hash, int score, int depth, TTBound bound, const Move& bestMove,
+               int eval = TTEntry::NO_EVAL);
+    // Called once per search, never per iteration: the generation is 6 bits, so
+    // ageing it through the iterations of a long search would wrap it and make
+    // old entries look new.
     void newSearch();
     void clear();
 
+    // Reallocates the table (rounded down to a power of two clusters), emptied.
+    void resize(size_t sizeMB);
+
+    // Adds a hot table of sizeKB (rounded down to a power of two clusters), or
+    // removes it when sizeKB is 0. Either way the table starts empty.
+    void setHotTable(size_t sizeKB);
+    size_t hotClusterCount() const { return hotClusters_.size(); }
+
+    // Half the L2 cache, within [64 KB, 1 MB]; 256 KB when the L2 size is unknown.
+    static size_t defaultHotTableKB();
+
+    // Moves the table to a NUMA node (see bindMemoryToNode); false when it was not moved.
+    bool bindToNode(int node);
+
     size_t clusterCount() const { return mask_ + 1; }
     size_t entryCount() const { return clusterCount() * 4; }
     size_t usedEntries() const;
@@ -190,16 +263,40 @@ public:
         return 100.0 * static_cast<double>(usedEntries()) / static_cast<double>(entryCount());
     }
 
+    // Permille of the first 1000 entries written by the current search (UCI hashfull)
+    int hashfull() const;
+
+    // Content histograms from up to maxClusters evenly spaced clusters (see TTDiagnostics.h)
+    TTDiagnostics sample(size_t maxClusters = DEFAULT_DIAGNOSTIC_SAMPLE) const;
+
     TTStats& stats() { return stats_; }
     const TTStats& stats() const { return stats_; }
 
 private:
     // Hash selects cluster index; upper 16 bits stored for entry verification.
-    size_t clusterIndex(uint64_t hash) const { return static_cast<size_t>(hash) & mask_; }
+    size_t clusterIndex(uint64_t hash) const { return hash & mask_; }
+    size_t hotIndex(uint64_t hash) const { return hash & hotMask_; }
     static uint16_t verifyKey(uint64_t hash) { return static_cast<uint16_t>(hash >> 48); }
+    bool isHot(int depth) const { return depth <= HOT_MAX_DEPTH && !hotClusters_.empty(); }
+
+    static bool findEntry(const TTCluster& cluster, uint16_t key16, TTEntry& out) {
+        for (int i = 0; i < 4; ++i) {
+            const TTEntry& e = cluster.entries[i];
+            if (e.hashVerify == key16 && !e.isEmpty()) {
+                out = e;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void storeInCluster(TTCluster& cluster, uint16_t key16, int score, int depth, TTBound bound,
+                        const Move& bestMove, int eval);
 
     std::vector<TTCluster> clusters_;
     size_t mask_ = 0;         // clusterCount - 1 (power of two)
+    std::vector<TTCluster> hotClusters_;  // empty: single-level table
+    size_t hotMask_ = 0;
     uint8_t generation_ = 0;  // 6-bit, wraps at 64
     TTStats stats_;
 };
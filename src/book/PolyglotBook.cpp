@@ -326,6 +326,13 @@ static uint32_t readU32Be(const uint8_t* p) {
            (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
 }
 
+static void writeBe(uint8_t* p, uint64_t value, int bytes) {
+    for (int i = bytes - 1; i >= 0; --i) {
+        p[i] = static_cast<uint8_t>(value & 0xFF);
+        value >>= 8;
+    }
+}
+
 // ---------------------------------------------------------------------------
 // decodePolyglotMove
 // ---------------------------------------------------------------------------
@@ -375,28 +382,43 @@ std::optional<Move> decodePolyglotMove(uint16_t pgMove, const Board& board) {
     return board.findLegalMove(from, to, pt);
 }
 
+uint16_t encodePolyglotMove(const Move& move) {
+    Square to = move.to();
+    if (move.isCastling()) {
+        Rank rank = getRank(to);
+        to = makeSquare(getFile(to) == FILE_G ? FILE_H : FILE_A, rank);
+    }
+
+    int promo = 0;
+    switch (move.promotion()) {
+        case PieceType::Knight:
+            promo = 1;
+            break;
+        case PieceType::Bishop:
+            promo = 2;
+            break;
+        case PieceType::Rook:
+            promo = 3;
+            break;
+        case PieceType::Queen:
+            promo = 4;
+            break;
+        default:
+            break;
+    }
+
+    int bits = static_cast<int>(getFile(to)) | (static_cast<int>(getRank(to)) << 3) |
+               (static_cast<int>(getFile(move.from())) << 6) |
+               (static_cast<int>(getRank(move.from())) << 9) | (promo << 12);
+    return static_cast<uint16_t>(bits);
+}
+
 // ---------------------------------------------------------------------------
 // PolyglotBook implementation
 // ---------------------------------------------------------------------------
 
 bool PolyglotBook::load(const std::string& path) {
-    entries_.clear();
-
-    std::ifstream f(path, std::ios::binary);
-    if (!f)
-        return false;
-
-    constexpr int kEntrySize = 16;
-    uint8_t buf[kEntrySize];
-    while (f.read(reinterpret_cast<char*>(buf), kEntrySize)) {
-        BookEntry e;
-        e.key = readU64Be(buf + 0);
-        e.move = readU16Be(buf + 8);
-        e.weight = readU16Be(buf + 10);
-        e.learn = readU32Be(buf + 12);
-        entries_.push_back(e);
-    }
-
+    entries_ = readPolyglotBook(path);
     if (entries_.empty())
         return false;
 
@@ -450,5 +472,44 @@ std::optional<uint16_t> PolyglotBook::probe(uint64_t key) const {
     return start->move;  // fallback (should not be reached)
 }
 
+std::vector<BookEntry> readPolyglotBook(const std::string& path) {
+    std::vector<BookEntry> entries;
+    std::ifstream f(path, std::ios::binary);
+    if (!f)
+        return entries;
+
+    constexpr int kEntrySize = 16;
+    uint8_t buf[kEntrySize];
+    while (f.read(reinterpret_cast<char*>(buf), kEntrySize)) {
+        BookEntry e;
+        e.key = readU64Be(buf + 0);
+        e.move = readU16Be(buf + 8);
+        e.weight = readU16Be(buf + 10);
+        e.learn = readU32Be(buf + 12);
+        entries.push_back(e);
+    }
+    return entries;
+}
+
+bool writePolyglotBook(const std::string& path, std::vector<BookEntry> entries) {
+    std::sort(entries.begin(), entries.end(), [](const BookEntry& a, const BookEntry& b) {
+        return a.key != b.key ? a.key < b.key : a.weight > b.weight;
+    });
+
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    if (!f)
+        return false;
+
+    uint8_t buf[16];
+    for (const BookEntry& e : entries) {
+        writeBe(buf + 0, e.key, 8);
+        writeBe(buf + 8, e.move, 2);
+        writeBe(buf + 10, e.weight, 2);
+        writeBe(buf + 12, e.learn, 4);
+        f.write(reinterpret_cast<const char*>(buf), sizeof(buf));
+    }
+    return static_cast<bool>(f);
+}
+
 }  // namespace book
 }  // namespace cchess
@@ -27,6 +27,10 @@ uint64_t computePolyglotKey(const Position& pos);
 // Returns the validated legal Move, or nullopt on hash collision / illegal entry.
 std::optional<Move> decodePolyglotMove(uint16_t pgMove, const Board& board);
 
+// Encodes a move in Polyglot form, castling as king-to-rook-corner; the inverse
+// of decodePolyglotMove.
+uint16_t encodePolyglotMove(const Move& move);
+
 // A single entry from a Polyglot .bin opening book file.
 struct BookEntry {
     uint64_t key;     // Polyglot Zobrist hash of the position
@@ -57,6 +61,14 @@ private:
     std::vector<BookEntry> entries_;  // sorted by key ascending
 };
 
+// Reads every entry of a Polyglot .bin file, in file order; empty if the file
+// cannot be opened.
+std::vector<BookEntry> readPolyglotBook(const std::string& path);
+
+// Writes entries as a Polyglot .bin file (big-endian, sorted by key and, within
+// a position, by descending weight). Returns false if the file cannot be written.
+bool writePolyglotBook(const std::string& path, std::vector<BookEntry> entries);
+
 }  // namespace book
 }  // namespace cchess
 
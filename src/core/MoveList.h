@@ -4,6 +4,7 @@
 #include "Move.h"
 
 #include <array>
+#include <cassert>
 #include <cstddef>
 
 namespace cchess {
@@ -11,9 +12,14 @@ namespace cchess {
 class MoveList {
 public:
     using value_type = Move;
+    static constexpr size_t CAPACITY = 256;  // above the 218 legal moves of any position
+
     MoveList() : size_(0) {}
 
-    void push_back(const Move& move) { moves_[size_++] = move; }
+    void push_back(const Move& move) {
+        assert(size_ < CAPACITY);
+        moves_[size_++] = move;
+    }
 
     size_t size() const { return size_; }
     bool empty() const { return size_ == 0; }
@@ -27,7 +33,7 @@ public:
     Move* end() { return moves_.data() + size_; }
 
 private:
-    std::array<Move, 256> moves_;
+    std::array<Move, CAPACITY> moves_;
     size_t size_;
 };
 
@@ -4,6 +4,8 @@
 #include "Square.h"
 #include "movegen/MoveGenerator.h"
 
+#include <algorithm>
+
 namespace cchess {
 
 static char pieceTypeToChar(PieceType pt) {
@@ -27,26 +29,12 @@ static char promotionChar(PieceType pt) {
     }
 }
 
-std::string moveToSan(const Board& board, const Move& move) {
-    if (move.isNull()) {
-        return "--";
-    }
-
-    // Castling
-    if (move.isCastling()) {
-        bool kingside = getFile(move.to()) > getFile(move.from());
-        std::string san = kingside ? "O-O" : "O-O-O";
-
-        // Check/checkmate suffix: make the move on a copy
-        Board copy = board;
-        copy.makeMoveUnchecked(move);
-        if (copy.isInCheck()) {
-            san += copy.isCheckmate() ? "#" : "+";
-        }
-        return san;
-    }
+// SAN without the check suffix. legalMoves must be the position's legal moves when the
+// moving piece is not a pawn (they are only used to disambiguate piece moves).
+static std::string sanBody(const Position& pos, const Move& move, const MoveList& legalMoves) {
+    if (move.isCastling())
+        return getFile(move.to()) > getFile(move.from()) ? "O-O" : "O-O-O";
 
-    const Position& pos = board.position();
     PieceType pt = pos.pieceAt(move.from()).type();
     Square from = move.from();
     Square to = move.to();
@@ -72,7 +60,6 @@ std::string moveToSan(const Board& board, const Move& move) {
         san += pieceTypeToChar(pt);
 
         // Disambiguation: check other pieces of same type that can reach the same square
-        MoveList legalMoves = board.getLegalMoves();
         bool needFile = false;
         bool needRank = false;
         bool ambiguous = false;
@@ -103,14 +90,90 @@ std::string moveToSan(const Board& board, const Move& move) {
         san += squareToString(to);
     }
 
-    // Check/checkmate suffix
-    Board copy = board;
-    copy.makeMoveUnchecked(move);
-    if (copy.isInCheck()) {
-        san += copy.isCheckmate() ? "#" : "+";
+    return san;
+}
+
+// "+", "#" or "" for a legal move, found by making and unmaking it on scratch.
+static const char* checkSuffix(Position& scratch, const Move& move) {
+    UndoInfo undo = scratch.makeMove(move);
+    const char* suffix = "";
+    if (MoveGenerator::isInCheck(scratch, scratch.sideToMove()))
+        suffix = MoveGenerator::generateLegalMoves(scratch).empty() ? "#" : "+";
+    scratch.unmakeMove(move, undo);
+    return suffix;
+}
+
+std::string moveToSan(const Board& board, const Move& move) {
+    if (move.isNull()) {
+        return "--";
     }
 
-    return san;
+    const Position& pos = board.position();
+    bool needsLegalMoves = !move.isCastling() && pos.pieceAt(move.from()).type() != PieceType::Pawn;
+    MoveList legalMoves;
+    if (needsLegalMoves)
+        legalMoves = MoveGenerator::generateLegalMoves(pos);
+
+    Position scratch = pos;
+    return sanBody(pos, move, legalMoves) + checkSuffix(scratch, move);
+}
+
+std::vector<std::string> movesToSan(const Board& board, const MoveList& legalMoves) {
+    const Position& pos = board.position();
+    Position scratch = pos;
+    std::vector<std::string> sans;
+    sans.reserve(legalMoves.size());
+    for (const Move& m : legalMoves)
+        sans.push_back(sanBody(pos, m, legalMoves) + checkSuffix(scratch, m));
+    return sans;
+}
+
+std::vector<std::string> pvToSan(const Board& board, const Move* pv, size_t length) {
+    Position scratch = board.position();
+    std::vector<std::string> sans;
+    sans.reserve(length);
+    for (size_t i = 0; i < length; ++i) {
+        const Move& m = pv[i];
+        MoveList legalMoves = MoveGenerator::generateLegalMoves(scratch);
+        if (std::find(legalMoves.begin(), legalMoves.end(), m) == legalMoves.end())
+            break;
+        std::string san = sanBody(scratch, m, legalMoves);
+        san += checkSuffix(scratch, m);
+        sans.push_back(std::move(san));
+        scratch.makeMove(m);
+    }
+    return sans;
+}
+
+std::optional<Move> sanToMove(const Board& board, const std::string& san) {
+    // Strip check/mate suffixes and annotation glyphs
+    std::string text = san;
+    while (!text.empty() && (text.back() == '+' || text.back() == '#' || text.back() == '!' ||
+                             text.back() == '?'))
+        text.pop_back();
+
+    // Some PGN writers use zeros for castling
+    if (text == "0-0")
+        text = "O-O";
+    else if (text == "0-0-0")
+        text = "O-O-O";
+
+    if (text.empty())
+        return std::nullopt;
+
+    // Render every legal move without its check suffix and compare; this reuses the SAN
+    // disambiguation rules instead of re-implementing them for the reverse direction.
+    const Position& pos = board.position();
+    std::optional<Move> match;
+    MoveList legalMoves = board.getLegalMoves();
+    for (const Move& m : legalMoves) {
+        if (sanBody(pos, m, legalMoves) == text) {
+            if (match)
+                return std::nullopt;  // ambiguous input
+            match = m;
+        }
+    }
+    return match;
 }
 
 }  // namespace cchess
@@ -2,8 +2,12 @@
 #define CCHESS_NOTATION_H
 
 #include "Move.h"
+#include "MoveList.h"
 
+#include <cstddef>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace cchess {
 
@@ -13,6 +17,26 @@ class Board;
 // The board must reflect the position BEFORE the move is made.
 std::string moveToSan(const Board& board, const Move& move);
 
+// SAN for every move of legalMoves, which must be the board's legal moves. Shares the
+// one move generation for disambiguation and finds check and mate suffixes by making
+// and unmaking each move on a single scratch position, so it costs about as much as
+// one moveToSan per move minus the copies and generations.
+std::vector<std::string> movesToSan(const Board& board, const MoveList& legalMoves);
+
+// SAN for a line of moves played from the board's position (a PV). Stops at the first
+// move that is not legal where it is played, so the result may be shorter than the line.
+std::vector<std::string> pvToSan(const Board& board, const Move* pv, size_t length);
+
+template <typename MoveRange>
+std::vector<std::string> pvToSan(const Board& board, const MoveRange& pv) {
+    return pvToSan(board, pv.size() ? &*pv.begin() : nullptr, pv.size());
+}
+
+// Parse a SAN string (e.g. "Nbd7", "exd6", "O-O", "e8=Q+") into the matching legal move.
+// Check/mate suffixes and annotation glyphs ("!", "?") are ignored. Returns nullopt if the
+// string does not name exactly one legal move in the current position.
+std::optional<Move> sanToMove(const Board& board, const std::string& san);
+
 }  // namespace cchess
 
 #endif  // CCHESS_NOTATION_H
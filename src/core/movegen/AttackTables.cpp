@@ -1,5 +1,6 @@
 #include "AttackTables.h"
 
+#include <cassert>
 #include <cstring>
 
 namespace cchess {
@@ -14,8 +15,15 @@ uint64_t ROOK_MAGICS[64];
 uint64_t BISHOP_MAGICS[64];
 int ROOK_SHIFTS[64];
 int BISHOP_SHIFTS[64];
+#ifdef CCHESS_LOW_MEMORY
+Bitboard ROOK_TABLE[ROOK_TABLE_SIZE];
+Bitboard BISHOP_TABLE[BISHOP_TABLE_SIZE];
+Bitboard* ROOK_SLICES[64];
+Bitboard* BISHOP_SLICES[64];
+#else
 Bitboard ROOK_TABLE[64][4096];   // 2MB — plain magics, max 12 relevant bits
 Bitboard BISHOP_TABLE[64][512];  // 256KB — plain magics, max 9 relevant bits
+#endif
 
 // Direction offsets for sliding pieces (used during magic table init)
 static const int ROOK_DIRECTIONS[][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
@@ -164,19 +172,38 @@ bool initAttackTables() {
     }
 
     // Initialize magic bitboard tables
+#ifdef CCHESS_LOW_MEMORY
+    size_t rookOffset = 0;
+    size_t bishopOffset = 0;
+#endif
     for (Square sq = 0; sq < 64; ++sq) {
         // Rook
         ROOK_MASKS[sq] = computeRookMask(sq);
         int rookBits = popCount(ROOK_MASKS[sq]);
         ROOK_SHIFTS[sq] = 64 - rookBits;
+#ifdef CCHESS_LOW_MEMORY
+        ROOK_SLICES[sq] = ROOK_TABLE + rookOffset;
+        rookOffset += size_t{1} << rookBits;
+        ROOK_MAGICS[sq] = findMagic(sq, ROOK_MASKS[sq], rookBits, ROOK_SLICES[sq]);
+#else
         ROOK_MAGICS[sq] = findMagic(sq, ROOK_MASKS[sq], rookBits, ROOK_TABLE[sq]);
+#endif
 
         // Bishop
         BISHOP_MASKS[sq] = computeBishopMask(sq);
         int bishopBits = popCount(BISHOP_MASKS[sq]);
         BISHOP_SHIFTS[sq] = 64 - bishopBits;
+#ifdef CCHESS_LOW_MEMORY
+        BISHOP_SLICES[sq] = BISHOP_TABLE + bishopOffset;
+        bishopOffset += size_t{1} << bishopBits;
+        BISHOP_MAGICS[sq] = findMagic(sq, BISHOP_MASKS[sq], bishopBits, BISHOP_SLICES[sq]);
+#else
         BISHOP_MAGICS[sq] = findMagic(sq, BISHOP_MASKS[sq], bishopBits, BISHOP_TABLE[sq]);
+#endif
     }
+#ifdef CCHESS_LOW_MEMORY
+    assert(rookOffset == ROOK_TABLE_SIZE && bishopOffset == BISHOP_TABLE_SIZE);
+#endif
 
     return true;
 }
@@ -1,6 +1,7 @@
 #include "MoveGenerator.h"
 
 #include "AttackTables.h"
+#include "../../utils/CpuFeatures.h"
 
 #include <algorithm>
 #include <iterator>
@@ -11,6 +12,7 @@ namespace cchess {
 // Per-Piece Move Generators
 // ============================================================================
 
+CCHESS_MULTIVERSION
 void MoveGenerator::generatePawnMoves(const Position& pos, Square from, MoveList& moves) {
     Color us = pos.pieceAt(from).color();
 
@@ -77,6 +79,7 @@ void MoveGenerator::generatePawnMoves(const Position& pos, Square from, MoveList
     }
 }
 
+CCHESS_MULTIVERSION
 Bitboard MoveGenerator::pieceAttacks(PieceType pt, Square sq, Bitboard occupied) {
     switch (pt) {
         case PieceType::Knight:
@@ -104,6 +107,7 @@ void MoveGenerator::serializeMoves(Square from, Bitboard targets, Bitboard enemi
         moves.push_back(Move(from, popLsb(quiets), MoveType::Normal));
 }
 
+CCHESS_MULTIVERSION
 void MoveGenerator::generatePieceMoves(const Position& pos, Square from, MoveList& moves) {
     const Piece& piece = pos.pieceAt(from);
     Bitboard occupied = pos.occupied();
@@ -111,6 +115,7 @@ void MoveGenerator::generatePieceMoves(const Position& pos, Square from, MoveLis
     serializeMoves(from, targets, pos.pieces(~piece.color()), moves);
 }
 
+CCHESS_MULTIVERSION
 void MoveGenerator::generateCastlingMoves(const Position& pos, MoveList& moves) {
     Color us = pos.sideToMove();
     Square kingSquare = pos.kingSquare(us);
@@ -161,6 +166,7 @@ void MoveGenerator::generateCastlingMoves(const Position& pos, MoveList& moves)
 // Pseudo-Legal Move Generation
 // ============================================================================
 
+CCHESS_MULTIVERSION
 MoveList MoveGenerator::generatePseudoLegalMoves(const Position& pos) {
     MoveList moves;
 
@@ -187,6 +193,7 @@ MoveList MoveGenerator::generatePseudoLegalMoves(const Position& pos) {
 // Check Detection
 // ============================================================================
 
+CCHESS_MULTIVERSION
 bool MoveGenerator::isSquareAttacked(const Position& pos, Square sq, Color byColor) {
     // Knight attacks (precomputed table lookup)
     if (KNIGHT_ATTACKS[sq] & pos.pieces(PieceType::Knight, byColor))
@@ -226,6 +233,7 @@ bool MoveGenerator::isSquareAttacked(const Position& pos, Square sq, Color byCol
     return false;
 }
 
+CCHESS_MULTIVERSION
 bool MoveGenerator::isInCheck(const Position& pos, Color side) {
     Square kingSq = pos.kingSquare(side);
     return kingSq != SQUARE_NONE && isSquareAttacked(pos, kingSq, ~side);
@@ -243,6 +251,7 @@ bool MoveGenerator::moveLeavesKingInCheck(Position& pos, const Move& move) {
 // Capture/Promotion-Only Generation (for quiescence search)
 // ============================================================================
 
+CCHESS_MULTIVERSION
 void MoveGenerator::generatePawnCaptures(const Position& pos, Square from, MoveList& moves) {
     Color us = pos.pieceAt(from).color();
     File fromFile = getFile(from);
@@ -290,6 +299,7 @@ void MoveGenerator::generatePawnCaptures(const Position& pos, Square from, MoveL
     }
 }
 
+CCHESS_MULTIVERSION
 MoveList MoveGenerator::generatePseudoLegalCaptures(const Position& pos) {
     MoveList moves;
     Color us = pos.sideToMove();
@@ -311,6 +321,7 @@ MoveList MoveGenerator::generatePseudoLegalCaptures(const Position& pos) {
     return moves;
 }
 
+CCHESS_MULTIVERSION
 MoveList MoveGenerator::generateLegalCaptures(const Position& pos) {
     MoveList pseudoLegal = generatePseudoLegalCaptures(pos);
     MoveList legal;
@@ -327,6 +338,7 @@ MoveList MoveGenerator::generateLegalCaptures(const Position& pos) {
 // Legal Move Generation
 // ============================================================================
 
+CCHESS_MULTIVERSION
 MoveList MoveGenerator::generateLegalMoves(const Position& pos) {
     MoveList pseudoLegal = generatePseudoLegalMoves(pos);
     MoveList legal;
@@ -367,6 +379,7 @@ bool MoveGenerator::isStalemate(const Position& pos) {
     return !isInCheck(pos, us) && generateLegalMoves(pos).empty();
 }
 
+CCHESS_MULTIVERSION
 bool MoveGenerator::isInsufficientMaterial(const Position& pos) {
     // Any pawn, rook, or queen means mate is theoretically possible
     if (pos.pieces(PieceType::Pawn) | pos.pieces(PieceType::Rook) | pos.pieces(PieceType::Queen))
@@ -1,44 +1,80 @@
+#include "ai/SearchTrace.h"
 #include "core/Board.h"
 #include "core/Square.h"
 #include "core/Zobrist.h"
 #include "display/BoardRenderer.h"
+#include "mode/AnalysisServer.h"
+#include "mode/BatchAnalysis.h"
+#include "mode/BookExpansion.h"
 #include "mode/EngineMatch.h"
+#include "mode/MateRunner.h"
 #include "mode/OpponentList.h"
 #include "mode/PerftRunner.h"
+#include "mode/PlayerVsEngine.h"
 #include "mode/PlayerVsPlayer.h"
 #include "mode/ProfileBench.h"
 #include "mode/StsRunner.h"
 #include "uci/Uci.h"
 #include "utils/Error.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <exception>
 #include <iostream>
 #include <limits>
+#include <string>
 #include <vector>
 
 void showMenu() {
     std::cout << "\n========== CChess ==========\n";
     std::cout << "1. Player vs Player\n";
-    std::cout << "2. Engine vs Engine\n";
-    std::cout << "3. Perft Test\n";
-    std::cout << "4. STS Benchmark\n";
-    std::cout << "5. Exit\n";
+    std::cout << "2. Player vs Engine\n";
+    std::cout << "3. Engine vs Engine\n";
+    std::cout << "4. Perft Test\n";
+    std::cout << "5. STS Benchmark\n";
+    std::cout << "6. Exit\n";
     std::cout << "===========================\n";
     std::cout << "Select option: ";
 }
 
 int getMenuChoice() {
     int choice;
-    while (!(std::cin >> choice) || choice < 1 || choice > 5) {
+    while (!(std::cin >> choice) || choice < 1 || choice > 6) {
         std::cin.clear();
         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-        std::cout << "Invalid choice. Please enter 1-5: ";
+        std::cout << "Invalid choice. Please enter 1-6: ";
     }
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     return choice;
 }
 
+void runPlayerVsEngine() {
+    std::cout << "Play as (w/b) [w]: ";
+    std::string side;
+    std::getline(std::cin, side);
+    cchess::Color human = (!side.empty() && (side[0] == 'b' || side[0] == 'B'))
+                              ? cchess::Color::Black
+                              : cchess::Color::White;
+
+    std::cout << "Engine seconds per move [5]: ";
+    std::string secondsInput;
+    std::getline(std::cin, secondsInput);
+    int seconds = 5;
+    try {
+        if (!secondsInput.empty())
+            seconds = std::max(1, std::stoi(secondsInput));
+    } catch (const std::exception&) {}
+
+    std::cout << "Ponder on your time (y/n) [y]: ";
+    std::string ponderInput;
+    std::getline(std::cin, ponderInput);
+    bool ponder = ponderInput.empty() || (ponderInput[0] != 'n' && ponderInput[0] != 'N');
+
+    cchess::PlayerVsEngine game(human, std::chrono::seconds(seconds), ponder);
+    game.play();
+}
+
 void runEngineMatch() {
     std::vector<cchess::Opponent> opponents;
     try {
@@ -71,11 +107,164 @@ void runEngineMatch() {
     if (pick == maxPick)
         return;
 
+    std::cout << "Adjudicate decided games (y/n) [y]: ";
+    std::string adjudicateInput;
+    std::getline(std::cin, adjudicateInput);
+    cchess::AdjudicationConfig adjudication;
+    adjudication.enabled =
+        adjudicateInput.empty() || (adjudicateInput[0] != 'n' && adjudicateInput[0] != 'N');
+
+    std::cout << "Telemetry JSONL file (empty = off): ";
+    std::string telemetryPath;
+    std::getline(std::cin, telemetryPath);
+
     cchess::EngineMatch match(opponents[static_cast<size_t>(pick - 1)], 180000, 2000,
-                              "engines/book.bin");
+                              "engines/book.bin", adjudication, telemetryPath);
     match.playSeries();
 }
 
+// Parses "--analyse <file> [--depth D] [--nodes N] [--threads T] [--hash MB] [--unordered]
+// [--affinity auto|<cpu-list>] [--telemetry <file.jsonl>]".
+int runBatchAnalysis(int argc, char* argv[]) {
+    cchess::BatchAnalysisOptions options;
+    options.inputPath = argv[2];
+    try {
+        for (int i = 3; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--depth" && hasValue)
+                options.depth = std::stoi(argv[++i]);
+            else if (arg == "--nodes" && hasValue)
+                options.nodes = std::stoull(argv[++i]);
+            else if (arg == "--threads" && hasValue)
+                options.threads = std::stoi(argv[++i]);
+            else if (arg == "--hash" && hasValue)
+                options.hashMB = std::stoul(argv[++i]);
+            else if (arg == "--unordered")
+                options.ordered = false;
+            else if (arg == "--affinity" && hasValue)
+                options.affinity = argv[++i];
+            else if (arg == "--telemetry" && hasValue)
+                options.telemetryPath = argv[++i];
+            else {
+                std::cerr << "Unknown analyse argument: " << arg << "\n";
+                return 1;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid numeric value for analyse argument\n";
+        return 1;
+    }
+    return cchess::BatchAnalysis::run(options);
+}
+
+// Parses "--serve <socket> [--threads T] [--hash MB] [--affinity auto|<cpu-list>]".
+int runAnalysisServer(int argc, char* argv[]) {
+    cchess::AnalysisServerOptions options;
+    options.socketPath = argv[2];
+    try {
+        for (int i = 3; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--threads" && hasValue)
+                options.threads = std::stoi(argv[++i]);
+            else if (arg == "--hash" && hasValue)
+                options.hashMB = std::stoul(argv[++i]);
+            else if (arg == "--affinity" && hasValue)
+                options.affinity = argv[++i];
+            else {
+                std::cerr << "Unknown serve argument: " << arg << "\n";
+                return 1;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid numeric value for serve argument\n";
+        return 1;
+    }
+    return cchess::AnalysisServer::run(options);
+}
+
+// Parses "--solve-mate <file.epd> [--mate N] [--time MS] [--hash MB]".
+int runSolveMate(int argc, char* argv[]) {
+    cchess::MateRunnerOptions options;
+    options.inputPath = argv[2];
+    try {
+        for (int i = 3; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--mate" && hasValue)
+                options.maxMoves = std::stoi(argv[++i]);
+            else if (arg == "--time" && hasValue)
+                options.timeMs = std::stoi(argv[++i]);
+            else if (arg == "--hash" && hasValue)
+                options.hashMB = std::stoul(argv[++i]);
+            else {
+                std::cerr << "Unknown solve-mate argument: " << arg << "\n";
+                return 1;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid numeric value for solve-mate argument\n";
+        return 1;
+    }
+    return cchess::MateRunner::run(options);
+}
+
+// Parses "--expand-book <book.bin> [--expansions N] [--nodes N] [--threads T] [--hash MB]
+// [--max-ply P] [--max-loss CP] [--ply-cost CP] [--checkpoint FILE] [--fen FEN]
+// [--affinity auto|<cpu-list>]".
+int runExpandBook(int argc, char* argv[]) {
+    cchess::BookExpansionOptions options;
+    options.bookPath = argv[2];
+    try {
+        for (int i = 3; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--expansions" && hasValue)
+                options.expansions = std::stoi(argv[++i]);
+            else if (arg == "--nodes" && hasValue)
+                options.nodes = std::stoull(argv[++i]);
+            else if (arg == "--threads" && hasValue)
+                options.threads = std::stoi(argv[++i]);
+            else if (arg == "--hash" && hasValue)
+                options.hashMB = std::stoul(argv[++i]);
+            else if (arg == "--max-ply" && hasValue)
+                options.maxPly = std::stoi(argv[++i]);
+            else if (arg == "--max-loss" && hasValue)
+                options.maxLoss = std::stoi(argv[++i]);
+            else if (arg == "--ply-cost" && hasValue)
+                options.plyCost = std::stoi(argv[++i]);
+            else if (arg == "--checkpoint" && hasValue)
+                options.checkpointPath = argv[++i];
+            else if (arg == "--fen" && hasValue)
+                options.rootFen = argv[++i];
+            else if (arg == "--affinity" && hasValue)
+                options.affinity = argv[++i];
+            else {
+                std::cerr << "Unknown expand-book argument: " << arg << "\n";
+                return 1;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid numeric value for expand-book argument\n";
+        return 1;
+    }
+    return cchess::BookExpansion(options).run();
+}
+
+// Prints a summary of a trace written by --bench --trace or the UCI TraceFile option.
+int runTraceSummary(const std::string& path) {
+    uint64_t totalRecorded = 0;
+    auto records = cchess::SearchTrace::readFrom(path, &totalRecorded);
+    if (!records) {
+        std::cerr << "Cannot read trace file: " << path << "\n";
+        return 1;
+    }
+    std::cout << "Trace: " << path << " (" << totalRecorded << " nodes traced)\n";
+    cchess::SearchTrace::summarize(*records, std::cout);
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     cchess::zobrist::init();
 
@@ -87,15 +276,80 @@ int main(int argc, char* argv[]) {
 
     if (argc > 1 && std::strcmp(argv[1], "--bench") == 0) {
         int timeMs = 30000;
-        if (argc > 2) {
-            try {
-                timeMs = std::stoi(argv[2]);
-            } catch (...) {}
+        std::string jsonPath;
+        std::string tracePath;
+        std::string affinity;
+        for (int i = 2; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+                jsonPath = argv[++i];
+            } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+                tracePath = argv[++i];
+            } else if (std::strcmp(argv[i], "--affinity") == 0 && i + 1 < argc) {
+                affinity = argv[++i];
+            } else {
+                try {
+                    timeMs = std::stoi(argv[i]);
+                } catch (...) {}
+            }
         }
-        cchess::ProfileBench::run(timeMs);
+        cchess::ProfileBench::run(timeMs, jsonPath, tracePath, affinity);
         return 0;
     }
 
+    if (argc > 1 && std::strcmp(argv[1], "--bench-interleave") == 0) {
+        try {
+            int depth = argc > 2 ? std::stoi(argv[2]) : 7;
+            size_t width = argc > 3 ? std::stoul(argv[3]) : 8;
+            size_t hashMB = argc > 4 ? std::stoul(argv[4]) : 16;
+            return cchess::ProfileBench::runInterleaved(depth, width, hashMB);
+        } catch (const std::exception&) {
+            std::cerr << "Usage: cchess --bench-interleave [depth] [width] [hash_mb]\n";
+            return 1;
+        }
+    }
+
+    if (argc > 1 && std::strcmp(argv[1], "--bench-hot-tt") == 0) {
+        try {
+            int depth = argc > 2 ? std::stoi(argv[2]) : 10;
+            size_t hotKB = argc > 3 ? std::stoul(argv[3]) : 0;
+            std::vector<size_t> hashSizes;
+            for (int i = 4; i < argc; ++i)
+                hashSizes.push_back(std::stoul(argv[i]));
+            if (hashSizes.empty())
+                return cchess::ProfileBench::runHotTable(depth, hotKB);
+            return cchess::ProfileBench::runHotTable(depth, hotKB, hashSizes);
+        } catch (const std::exception&) {
+            std::cerr << "Usage: cchess --bench-hot-tt [depth] [hot_kb] [hash_mb ...]\n";
+            return 1;
+        }
+    }
+
+    if (argc > 1 && std::strcmp(argv[1], "--bench-correction") == 0) {
+        try {
+            int games = argc > 2 ? std::stoi(argv[2]) : 64;
+            uint64_t nodes = argc > 3 ? std::stoull(argv[3]) : 20000;
+            return cchess::ProfileBench::runCorrection(games, nodes);
+        } catch (const std::exception&) {
+            std::cerr << "Usage: cchess --bench-correction [games] [nodes]\n";
+            return 1;
+        }
+    }
+
+    if (argc > 2 && std::strcmp(argv[1], "--trace-summary") == 0)
+        return runTraceSummary(argv[2]);
+
+    if (argc > 2 && std::strcmp(argv[1], "--analyse") == 0)
+        return runBatchAnalysis(argc, argv);
+
+    if (argc > 2 && std::strcmp(argv[1], "--serve") == 0)
+        return runAnalysisServer(argc, argv);
+
+    if (argc > 2 && std::strcmp(argv[1], "--solve-mate") == 0)
+        return runSolveMate(argc, argv);
+
+    if (argc > 2 && std::strcmp(argv[1], "--expand-book") == 0)
+        return runExpandBook(argc, argv);
+
     try {
         while (true) {
             showMenu();
@@ -108,15 +362,18 @@ int main(int argc, char* argv[]) {
                     break;
                 }
                 case 2:
-                    runEngineMatch();
+                    runPlayerVsEngine();
                     break;
                 case 3:
-                    cchess::PerftRunner::run();
+                    runEngineMatch();
                     break;
                 case 4:
-                    cchess::StsRunner::run();
+                    cchess::PerftRunner::run();
                     break;
                 case 5:
+                    cchess::StsRunner::run();
+                    break;
+                case 6:
                     std::cout << "Thanks for playing!\n";
                     return 0;
             }
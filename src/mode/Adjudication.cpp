@@ -0,0 +1,50 @@
+#include "mode/Adjudication.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace cchess {
+
+Adjudication Adjudicator::update(Color mover, int moveNumber, std::optional<int> whiteScore) {
+    Streaks& s = streaks_[static_cast<size_t>(mover)];
+    if (!config_.enabled)
+        return Adjudication::None;
+    if (!whiteScore) {
+        s = Streaks{};
+        return Adjudication::None;
+    }
+
+    int score = *whiteScore;
+    s.whiteLosing = score <= -config_.resignScore ? s.whiteLosing + 1 : 0;
+    s.blackLosing = score >= config_.resignScore ? s.blackLosing + 1 : 0;
+    s.drawish = std::abs(score) <= config_.drawScore ? s.drawish + 1 : 0;
+
+    const Streaks& white = streaks_[static_cast<size_t>(Color::White)];
+    const Streaks& black = streaks_[static_cast<size_t>(Color::Black)];
+    if (config_.resignMoves > 0) {
+        if (std::min(white.whiteLosing, black.whiteLosing) >= config_.resignMoves)
+            return Adjudication::BlackWins;
+        if (std::min(white.blackLosing, black.blackLosing) >= config_.resignMoves)
+            return Adjudication::WhiteWins;
+    }
+    if (config_.drawMoves > 0 && moveNumber >= config_.drawMoveNumber &&
+        std::min(white.drawish, black.drawish) >= config_.drawMoves)
+        return Adjudication::Draw;
+    return Adjudication::None;
+}
+
+bool isThreefoldRepetition(const std::vector<uint64_t>& hashes, int halfmoveClock) {
+    if (hashes.empty())
+        return false;
+    // Only positions with the same side to move and no irreversible move since
+    size_t last = hashes.size() - 1;
+    size_t reach = std::min(last, static_cast<size_t>(std::max(halfmoveClock, 0)));
+    int seen = 1;
+    for (size_t back = 2; back <= reach; back += 2) {
+        if (hashes[last - back] == hashes[last] && ++seen >= 3)
+            return true;
+    }
+    return false;
+}
+
+}  // namespace cchess
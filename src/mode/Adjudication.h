@@ -0,0 +1,54 @@
+#ifndef CCHESS_ADJUDICATION_H
+#define CCHESS_ADJUDICATION_H
+
+#include "core/Types.h"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace cchess {
+
+// When to stop a match game early. Both rules need the two engines to agree:
+// a game is only resigned when the loser's own scores and the winner's scores
+// have both been past resignScore for resignMoves moves each, and only drawn
+// when both have been within drawScore of zero for drawMoves moves each. A move
+// without a score (a book move, an engine that sends no info) resets the run.
+struct AdjudicationConfig {
+    bool enabled = true;
+    int resignScore = 700;    // centipawns
+    int resignMoves = 4;      // consecutive moves of each engine
+    int drawScore = 10;       // centipawns, either side of zero
+    int drawMoves = 8;        // consecutive moves of each engine
+    int drawMoveNumber = 40;  // no draw adjudication before this full move
+};
+
+enum class Adjudication { None, WhiteWins, BlackWins, Draw };
+
+class Adjudicator {
+public:
+    explicit Adjudicator(const AdjudicationConfig& config = {}) : config_(config) {}
+
+    // Records one engine's score (white-relative centipawns) for the move it just
+    // played at fullmove moveNumber and returns the verdict so far.
+    Adjudication update(Color mover, int moveNumber, std::optional<int> whiteScore);
+
+private:
+    struct Streaks {
+        int whiteLosing = 0;
+        int blackLosing = 0;
+        int drawish = 0;
+    };
+
+    AdjudicationConfig config_;
+    std::array<Streaks, 2> streaks_{};  // by engine colour
+};
+
+// True when the last position in hashes (one entry per position, starting
+// position first) occurred twice before since the last capture or pawn move.
+bool isThreefoldRepetition(const std::vector<uint64_t>& hashes, int halfmoveClock);
+
+}  // namespace cchess
+
+#endif  // CCHESS_ADJUDICATION_H
@@ -0,0 +1,387 @@
+#include "mode/AnalysisServer.h"
+
+#include <iostream>
+
+#ifdef _WIN32
+
+namespace cchess {
+
+int AnalysisServer::run(const AnalysisServerOptions&) {
+    std::cerr << "serve: Unix-domain sockets are not supported on this platform\n";
+    return 1;
+}
+
+}  // namespace cchess
+
+#else
+
+#include "ai/Search.h"
+#include "ai/SearchConfig.h"
+#include "ai/TranspositionTable.h"
+#include "core/Board.h"
+#include "uci/Uci.h"
+#include "utils/Affinity.h"
+#include "utils/Error.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cchess {
+
+namespace {
+
+// A connected client. Worker threads and the session's reader thread both
+// write replies, so writes are serialized by writeMutex.
+struct Session {
+    explicit Session(int socketFd) : fd(socketFd) {}
+    ~Session() { ::close(fd); }
+
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+
+    void send(const std::string& line) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        std::string data = line + "\n";
+        const char* p = data.data();
+        size_t left = data.size();
+        while (left > 0) {
+            ssize_t n = ::send(fd, p, left, 0);
+            if (n <= 0)
+                return;  // client went away; its requests are cancelled by the reader
+            p += n;
+            left -= static_cast<size_t>(n);
+        }
+    }
+
+    const int fd;
+    std::mutex writeMutex;
+    std::atomic<bool> finished{false};  // reader thread has exited
+    int nextTag = 1;                    // auto-assigned request tags (reader thread only)
+};
+
+struct Request {
+    std::shared_ptr<Session> session;
+    std::string tag;
+    Board board;
+    std::vector<uint64_t> history;
+    SearchConfig config;
+    int priority = 0;
+    uint64_t sequence = 0;
+    std::atomic<bool> stop{false};  // cancellation; also the search's stop signal
+};
+
+// Highest priority first, then oldest first.
+struct RequestOrder {
+    bool operator()(const std::shared_ptr<Request>& a, const std::shared_ptr<Request>& b) const {
+        if (a->priority != b->priority)
+            return a->priority < b->priority;
+        return a->sequence > b->sequence;
+    }
+};
+
+class Server {
+public:
+    explicit Server(const AnalysisServerOptions& options) : options_(options) {}
+
+    int run();
+
+private:
+    void workerLoop(size_t index);
+    void sessionLoop(const std::shared_ptr<Session>& session);
+    void handleGo(const std::shared_ptr<Session>& session, std::istringstream& args,
+                  const Board& board, const std::vector<uint64_t>& history);
+    void cancel(const Session* session, const std::string& tag);
+    void finishRequest(const std::shared_ptr<Request>& request);
+    void shutdown();
+
+    AnalysisServerOptions options_;
+    int listenFd_ = -1;
+    std::atomic<bool> stopping_{false};
+    ThreadPlacement placement_;
+
+    // Queued requests plus every live (queued or running) request, for cancellation
+    std::mutex queueMutex_;
+    std::condition_variable queueCv_;
+    std::priority_queue<std::shared_ptr<Request>, std::vector<std::shared_ptr<Request>>,
+                        RequestOrder>
+        queue_;
+    std::vector<std::shared_ptr<Request>> live_;
+    uint64_t nextSequence_ = 0;
+
+    std::mutex sessionsMutex_;
+    std::vector<std::pair<std::shared_ptr<Session>, std::thread>> sessions_;
+};
+
+int Server::run() {
+    try {
+        placement_ = ThreadPlacement::parse(options_.affinity);
+    } catch (const ChessError& e) {
+        std::cerr << "serve: " << e.what() << "\n";
+        return 1;
+    }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (options_.socketPath.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "serve: socket path too long: " << options_.socketPath << "\n";
+        return 1;
+    }
+    std::strncpy(addr.sun_path, options_.socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+    listenFd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd_ < 0) {
+        std::cerr << "serve: socket() failed: " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    ::unlink(options_.socketPath.c_str());
+    if (::bind(listenFd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(listenFd_, 16) < 0) {
+        std::cerr << "serve: cannot listen on " << options_.socketPath << ": "
+                  << std::strerror(errno) << "\n";
+        ::close(listenFd_);
+        return 1;
+    }
+
+    // A client closing mid-reply must not kill the process
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < static_cast<size_t>(std::max(1, options_.threads)); ++t)
+        workers.emplace_back([this, t]() { workerLoop(t); });
+
+    std::cerr << "serve: listening on " << options_.socketPath << " with " << workers.size()
+              << " worker(s), affinity " << placement_.describe() << "\n";
+
+    while (!stopping_.load()) {
+        int fd = ::accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR)
+                continue;
+            break;  // listening socket shut down
+        }
+
+        auto session = std::make_shared<Session>(fd);
+        std::lock_guard<std::mutex> lock(sessionsMutex_);
+
+        // Reap sessions whose reader has exited
+        for (auto it = sessions_.begin(); it != sessions_.end();) {
+            if (it->first->finished.load()) {
+                it->second.join();
+                it = sessions_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        sessions_.emplace_back(session, std::thread([this, session]() { sessionLoop(session); }));
+    }
+
+    // Unblock every session reader, then wait for readers and workers
+    {
+        std::lock_guard<std::mutex> lock(sessionsMutex_);
+        for (auto& [session, thread] : sessions_)
+            ::shutdown(session->fd, SHUT_RDWR);
+    }
+    for (auto& [session, thread] : sessions_)
+        thread.join();
+    sessions_.clear();
+
+    queueCv_.notify_all();
+    for (auto& w : workers)
+        w.join();
+
+    ::close(listenFd_);
+    ::unlink(options_.socketPath.c_str());
+    std::cerr << "serve: stopped\n";
+    return 0;
+}
+
+void Server::workerLoop(size_t index) {
+    // Pinned before the tables are allocated: first touch places them locally
+    placement_.pinCurrentThread(index);
+
+    // Tables stay alive across requests so later requests start warm
+    auto tt = std::make_unique<TranspositionTable>(options_.hashMB);
+    auto pawnTable = std::make_unique<eval::PawnTable>();
+    auto correction = std::make_unique<CorrectionHistory>();
+
+    while (true) {
+        std::shared_ptr<Request> request;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueCv_.wait(lock, [this]() { return stopping_.load() || !queue_.empty(); });
+            if (stopping_.load())
+                return;
+            request = queue_.top();
+            queue_.pop();
+        }
+
+        if (!request->stop.load()) {
+            const std::string prefix = "info request " + request->tag + " ";
+            std::shared_ptr<Session> session = request->session;
+            Search search(
+                request->board, request->config, *tt, *pawnTable, *correction,
+                [&](const SearchInfo& info) { session->send(prefix + Uci::formatInfo(info)); },
+                request->history);
+            Move best = search.findBestMove();
+            if (!request->stop.load())
+                session->send("bestmove request " + request->tag + " " + best.toAlgebraic());
+        }
+        finishRequest(request);
+    }
+}
+
+// Reports a cancelled request and forgets it.
+void Server::finishRequest(const std::shared_ptr<Request>& request) {
+    if (request->stop.load())
+        request->session->send("cancelled request " + request->tag);
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    live_.erase(std::remove(live_.begin(), live_.end(), request), live_.end());
+}
+
+void Server::sessionLoop(const std::shared_ptr<Session>& session) {
+    Board board;
+    std::vector<uint64_t> history;
+    std::string buffer;
+    char chunk[4096];
+
+    while (true) {
+        size_t newline = buffer.find('\n');
+        if (newline == std::string::npos) {
+            ssize_t n = ::recv(session->fd, chunk, sizeof(chunk), 0);
+            if (n <= 0)
+                break;
+            buffer.append(chunk, static_cast<size_t>(n));
+            continue;
+        }
+
+        std::string line = buffer.substr(0, newline);
+        buffer.erase(0, newline + 1);
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        std::istringstream iss(line);
+        std::string cmd;
+        iss >> cmd;
+
+        try {
+            if (cmd.empty()) {
+                continue;
+            } else if (cmd == "position") {
+                Uci::parsePosition(iss, board, history);
+            } else if (cmd == "go") {
+                handleGo(session, iss, board, history);
+            } else if (cmd == "stop") {
+                std::string tag;
+                iss >> tag;
+                cancel(session.get(), tag);
+            } else if (cmd == "isready") {
+                session->send("readyok");
+            } else if (cmd == "quit") {
+                break;
+            } else if (cmd == "shutdown") {
+                shutdown();
+                break;
+            } else {
+                session->send("error unknown command: " + cmd);
+            }
+        } catch (const ChessError& e) {
+            session->send(std::string("error ") + e.what());
+        }
+    }
+
+    cancel(session.get(), "");
+    session->finished.store(true);
+}
+
+void Server::handleGo(const std::shared_ptr<Session>& session, std::istringstream& args,
+                      const Board& board, const std::vector<uint64_t>& history) {
+    auto request = std::make_shared<Request>();
+    request->session = session;
+    request->board = board;
+    request->history = history;
+    request->config.stopSignal = &request->stop;
+
+    int depth = -1, movetime = -1;
+    uint64_t nodes = 0;
+    std::string token;
+    while (args >> token) {
+        if (token == "request")
+            args >> request->tag;
+        else if (token == "depth")
+            args >> depth;
+        else if (token == "nodes")
+            args >> nodes;
+        else if (token == "movetime")
+            args >> movetime;
+        else if (token == "priority")
+            args >> request->priority;
+    }
+    if (request->tag.empty())
+        request->tag = std::to_string(session->nextTag++);
+
+    // Explicit depth/node limits run without a clock unless movetime is also given
+    if (depth > 0)
+        request->config.maxDepth = depth;
+    request->config.maxNodes = nodes;
+    if (movetime > 0)
+        request->config.searchTime = std::chrono::milliseconds(movetime);
+    else if (depth > 0 || nodes > 0)
+        request->config.searchTime = std::chrono::hours(24);
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        request->sequence = nextSequence_++;
+        queue_.push(request);
+        live_.push_back(request);
+    }
+    queueCv_.notify_one();
+}
+
+// Cancels the session's request with the given tag, or all of them when tag is empty.
+// Queued requests are reported by the worker that dequeues them; running ones stop at
+// their next time check.
+void Server::cancel(const Session* session, const std::string& tag) {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    for (const auto& request : live_) {
+        if (request->session.get() == session && (tag.empty() || request->tag == tag))
+            request->stop.store(true);
+    }
+}
+
+void Server::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        stopping_.store(true);
+        for (const auto& request : live_)
+            request->stop.store(true);
+    }
+    queueCv_.notify_all();
+    ::shutdown(listenFd_, SHUT_RDWR);
+}
+
+}  // namespace
+
+int AnalysisServer::run(const AnalysisServerOptions& options) {
+    Server server(options);
+    return server.run();
+}
+
+}  // namespace cchess
+
+#endif  // _WIN32
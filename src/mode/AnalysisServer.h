@@ -0,0 +1,44 @@
+#ifndef CCHESS_ANALYSIS_SERVER_H
+#define CCHESS_ANALYSIS_SERVER_H
+
+#include "ai/TranspositionTable.h"
+
+#include <cstddef>
+#include <string>
+
+namespace cchess {
+
+struct AnalysisServerOptions {
+    std::string socketPath;
+    int threads = 1;        // worker threads shared by all sessions
+    size_t hashMB = TranspositionTable::DEFAULT_WORKER_SIZE_MB;  // per worker
+    std::string affinity;   // worker CPU placement: "auto" or a CPU list (see Affinity.h)
+};
+
+// Multi-session analysis server on a Unix-domain socket.
+// Usage: cchess --serve <socket-path> [--threads T] [--hash MB] [--affinity auto|<cpu-list>]
+//
+// Every connection is an independent session with its own position. Commands
+// are UCI-like lines:
+//   position startpos|fen <FEN> [moves ...]
+//   go [request <tag>] [depth D] [nodes N] [movetime MS] [priority P]
+//   stop [<tag>]          cancel one request, or every request of the session
+//   shutdown              stop the server
+// Replies carry the request tag so several requests can be in flight:
+//   info request <tag> depth ... score ... pv ...
+//   bestmove request <tag> <move>
+//   cancelled request <tag>
+//
+// Requests from all sessions share one worker pool and are served highest
+// priority first (FIFO within a priority). Workers and their tables live for
+// the whole process, so every request lands on a warm process and table. Each
+// worker owns its table: the TT is not safe to share between threads.
+class AnalysisServer {
+public:
+    // Blocks until "shutdown" is received. Returns a process exit code.
+    static int run(const AnalysisServerOptions& options);
+};
+
+}  // namespace cchess
+
+#endif  // CCHESS_ANALYSIS_SERVER_H
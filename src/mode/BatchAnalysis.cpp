@@ -0,0 +1,438 @@
+#include "mode/BatchAnalysis.h"
+
+#include "ai/Eval.h"
+#include "ai/Search.h"
+#include "ai/SearchConfig.h"
+#include "ai/TTDiagnostics.h"
+#include "ai/TranspositionTable.h"
+#include "core/Board.h"
+#include "core/Notation.h"
+#include "mode/Telemetry.h"
+#include "utils/Affinity.h"
+#include "utils/Error.h"
+#include "utils/StringUtils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <sstream>
+#include <thread>
+
+namespace cchess {
+
+namespace {
+
+// Depth/node limits bound every analysis; the time limit only has to be out of the way.
+constexpr std::chrono::milliseconds kNoTimeLimit = std::chrono::hours(24);
+
+// TT clusters sampled for the fill reported in telemetry
+constexpr size_t kTelemetryTTSample = 1024;
+
+bool endsWith(const std::string& s, const std::string& suffix) {
+    if (s.size() < suffix.size())
+        return false;
+    return std::equal(suffix.rbegin(), suffix.rend(), s.rbegin(), [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) ==
+               std::tolower(static_cast<unsigned char>(b));
+    });
+}
+
+bool isValidFen(const std::string& fen) {
+    try {
+        Board board(fen);
+        return true;
+    } catch (const ChessError&) {
+        return false;
+    }
+}
+
+bool isPgnResult(const std::string& token) {
+    return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+}
+
+// Builds the JSON "score" object using the same mate conversion as UCI output.
+nlohmann::json scoreToJson(int score) {
+    if (score >= eval::SCORE_MATE - 200)
+        return {{"mate", (eval::SCORE_MATE - score + 1) / 2}};
+    if (score <= -(eval::SCORE_MATE - 200))
+        return {{"mate", -((eval::SCORE_MATE + score + 1) / 2)}};
+    return {{"cp", score}};
+}
+
+// Analyses one job with the worker's tables and returns its JSON line.
+std::string analyse(const AnalysisJob& job, size_t index, const BatchAnalysisOptions& options,
+                    TranspositionTable& tt, eval::PawnTable& pawnTable,
+                    CorrectionHistory& correction, size_t worker,
+                    TelemetryWriter& telemetry) {
+    Board board(job.fen);
+
+    SearchConfig config;
+    config.searchTime = kNoTimeLimit;
+    if (options.depth > 0)
+        config.maxDepth = options.depth;
+    config.maxNodes = options.nodes;
+
+    SearchInfo lastInfo{};
+    TTStats ttBefore = tt.stats();
+    auto start = std::chrono::steady_clock::now();
+    Search search(board, config, tt, pawnTable, correction,
+                  [&lastInfo](const SearchInfo& info) { lastInfo = info; }, job.gameHistory);
+    Move best = search.findBestMove();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+    nlohmann::json out;
+    out["index"] = index;
+    out["id"] = job.id;
+    out["fen"] = job.fen;
+    out["depth"] = lastInfo.depth;
+    out["score"] = scoreToJson(lastInfo.score);
+    out["bestmove"] = best.isNull() ? nlohmann::json() : nlohmann::json(best.toAlgebraic());
+    nlohmann::json pv = nlohmann::json::array();
+    for (const auto& m : lastInfo.pv)
+        pv.push_back(m.toAlgebraic());
+    out["pv"] = std::move(pv);
+    out["pv_san"] = pvToSan(board, lastInfo.pv);
+    out["nodes"] = search.totalNodes();
+    out["time_ms"] = elapsed;
+
+    if (telemetry.enabled()) {
+        uint64_t probes = tt.stats().probes - ttBefore.probes;
+        uint64_t hits = tt.stats().hits - ttBefore.hits;
+        TTDiagnostics sample = tt.sample(kTelemetryTTSample);
+        telemetry.write(
+            {{"type", "analysis"},
+             {"index", index},
+             {"id", job.id},
+             {"worker", worker},
+             {"depth", lastInfo.depth},
+             {"nodes", search.totalNodes()},
+             {"time_ms", elapsed},
+             {"nps", elapsed > 0 ? search.totalNodes() * 1000 / static_cast<uint64_t>(elapsed) : 0},
+             {"tt_fill_permille",
+              sample.sampledSlots() ? sample.usedSlots() * 1000 / sample.sampledSlots() : 0},
+             {"tt_hit_rate",
+              probes ? 100.0 * static_cast<double>(hits) / static_cast<double>(probes) : 0.0}});
+    }
+    return out.dump();
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// Input parsing
+// ---------------------------------------------------------------------------
+
+std::vector<AnalysisJob> BatchAnalysis::parseEpd(std::istream& in) {
+    std::vector<AnalysisJob> jobs;
+    std::string line;
+    int lineNo = 0;
+
+    while (std::getline(in, line)) {
+        ++lineNo;
+        line = trim(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        // First 4 fields are the FEN parts; EPD omits the move counters but some
+        // files carry them anyway, so take two more fields when they are numeric.
+        std::istringstream ss(line);
+        std::string board, side, castling, ep;
+        if (!(ss >> board >> side >> castling >> ep))
+            continue;
+        std::string halfmove = "0", fullmove = "1";
+        std::string f5, f6;
+        auto afterEp = ss.tellg();
+        if ((ss >> f5 >> f6) && isInteger(f5) && isInteger(f6)) {
+            halfmove = f5;
+            fullmove = f6;
+        } else {
+            ss.clear();
+            ss.seekg(afterEp);
+        }
+
+        AnalysisJob job;
+        job.fen = board + " " + side + " " + castling + " " + ep + " " + halfmove + " " + fullmove;
+        if (!isValidFen(job.fen))
+            continue;
+
+        // id "..." opcode, falling back to the line number
+        auto idPos = line.find("id \"");
+        if (idPos != std::string::npos) {
+            auto idStart = idPos + 4;
+            auto idEnd = line.find('"', idStart);
+            if (idEnd != std::string::npos)
+                job.id = line.substr(idStart, idEnd - idStart);
+        }
+        if (job.id.empty())
+            job.id = "line " + std::to_string(lineNo);
+
+        jobs.push_back(std::move(job));
+    }
+    return jobs;
+}
+
+std::vector<AnalysisJob> BatchAnalysis::parsePgn(std::istream& in) {
+    std::vector<AnalysisJob> jobs;
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    const std::string text = buffer.str();
+
+    int gameNumber = 0;
+    bool inGame = false;   // a tag or move of the current game has been seen
+    bool inMoves = false;  // current game has reached its movetext
+    bool dead = false;     // an unparseable move ended the current game early
+    std::string startFen = Board::STARTING_FEN;
+    std::unique_ptr<Board> board;
+    std::vector<uint64_t> history;
+    int ply = 0;
+
+    auto finishGame = [&]() {
+        inGame = inMoves = dead = false;
+        startFen = Board::STARTING_FEN;
+        board.reset();
+        history.clear();
+        ply = 0;
+    };
+    auto beginGame = [&]() {
+        if (!inGame) {
+            inGame = true;
+            ++gameNumber;
+        }
+    };
+
+    size_t i = 0;
+    while (i < text.size()) {
+        char c = text[i];
+
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            ++i;
+        } else if (c == '[') {
+            // A tag after movetext without a result token starts a new game
+            if (inMoves)
+                finishGame();
+            beginGame();
+            auto end = text.find(']', i);
+            if (end == std::string::npos)
+                break;
+            std::string tag = text.substr(i + 1, end - i - 1);
+            i = end + 1;
+
+            std::istringstream ts(tag);
+            std::string name;
+            ts >> name;
+            auto q1 = tag.find('"');
+            auto q2 = tag.rfind('"');
+            if (name == "FEN" && q1 != std::string::npos && q2 > q1)
+                startFen = tag.substr(q1 + 1, q2 - q1 - 1);
+        } else if (c == '{') {
+            auto end = text.find('}', i);
+            i = (end == std::string::npos) ? text.size() : end + 1;
+        } else if (c == ';') {
+            auto end = text.find('\n', i);
+            i = (end == std::string::npos) ? text.size() : end + 1;
+        } else if (c == '(') {
+            // Skip the (possibly nested) variation; only the mainline is analysed
+            int nesting = 0;
+            while (i < text.size()) {
+                if (text[i] == '{') {
+                    auto end = text.find('}', i);
+                    i = (end == std::string::npos) ? text.size() : end + 1;
+                    continue;
+                }
+                if (text[i] == '(')
+                    ++nesting;
+                else if (text[i] == ')' && --nesting == 0) {
+                    ++i;
+                    break;
+                }
+                ++i;
+            }
+        } else if (c == ')' || c == ']' || c == '}') {
+            ++i;  // stray closer
+        } else {
+            size_t start = i;
+            while (i < text.size() && !std::isspace(static_cast<unsigned char>(text[i])) &&
+                   std::string("{}()[];").find(text[i]) == std::string::npos)
+                ++i;
+            std::string token = text.substr(start, i - start);
+
+            if (isPgnResult(token)) {
+                finishGame();
+                continue;
+            }
+            if (token[0] == '$')
+                continue;  // NAG
+
+            // Strip a leading move number ("12." / "12..." / "12.e4")
+            size_t p = 0;
+            while (p < token.size() && std::isdigit(static_cast<unsigned char>(token[p])))
+                ++p;
+            if (p > 0 && p < token.size() && token[p] == '.') {
+                while (p < token.size() && token[p] == '.')
+                    ++p;
+                token = token.substr(p);
+            } else if (p == token.size()) {
+                continue;  // bare number
+            }
+            if (token.empty())
+                continue;
+
+            beginGame();
+            inMoves = true;
+            if (dead)
+                continue;
+            if (!board) {
+                try {
+                    board = std::make_unique<Board>(startFen);
+                } catch (const ChessError&) {
+                    dead = true;
+                    continue;
+                }
+            }
+
+            auto move = sanToMove(*board, token);
+            if (!move) {
+                dead = true;
+                continue;
+            }
+
+            AnalysisJob job;
+            job.id = "game " + std::to_string(gameNumber) + " ply " + std::to_string(ply + 1);
+            job.fen = board->toFen();
+            job.gameHistory = history;
+            jobs.push_back(std::move(job));
+
+            history.push_back(board->position().hash());
+            board->makeMoveUnchecked(*move);
+            ++ply;
+        }
+    }
+    return jobs;
+}
+
+// ---------------------------------------------------------------------------
+// Driver
+// ---------------------------------------------------------------------------
+
+int BatchAnalysis::run(const BatchAnalysisOptions& options) {
+    if (options.depth <= 0 && options.nodes == 0) {
+        std::cerr << "analyse: specify --depth and/or --nodes\n";
+        return 1;
+    }
+
+    std::ifstream file(options.inputPath);
+    if (!file.is_open()) {
+        std::cerr << "analyse: cannot open " << options.inputPath << "\n";
+        return 1;
+    }
+
+    std::vector<AnalysisJob> jobs =
+        endsWith(options.inputPath, ".pgn") ? parsePgn(file) : parseEpd(file);
+    if (jobs.empty()) {
+        std::cerr << "analyse: no positions found in " << options.inputPath << "\n";
+        return 1;
+    }
+
+    ThreadPlacement placement;
+    try {
+        placement = ThreadPlacement::parse(options.affinity);
+    } catch (const ChessError& e) {
+        std::cerr << "analyse: " << e.what() << "\n";
+        return 1;
+    }
+
+    size_t threadCount = static_cast<size_t>(std::max(1, options.threads));
+    threadCount = std::min(threadCount, jobs.size());
+
+    std::unique_ptr<TelemetryWriter> telemetry;
+    try {
+        telemetry = options.telemetryPath.empty()
+                        ? std::make_unique<TelemetryWriter>()
+                        : std::make_unique<TelemetryWriter>(options.telemetryPath);
+    } catch (const ChessError& e) {
+        std::cerr << "analyse: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::cerr << "analyse: " << jobs.size() << " positions, " << threadCount
+              << " thread(s), affinity " << placement.describe() << "\n";
+
+    std::atomic<size_t> next{0};
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::vector<std::optional<std::string>> results(options.ordered ? jobs.size() : 0);
+
+    auto wallStart = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount);
+    for (size_t t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&, t]() {
+            // Pinned before the tables are allocated: first touch places them locally
+            placement.pinCurrentThread(t);
+            TranspositionTable tt(options.hashMB);
+            auto pawnTable = std::make_unique<eval::PawnTable>();
+            auto correction = std::make_unique<CorrectionHistory>();
+
+            for (size_t i = next.fetch_add(1); i < jobs.size(); i = next.fetch_add(1)) {
+                // Fresh tables per job, so a result does not depend on which jobs
+                // this worker happened to analyse before it, nor on --threads
+                tt.clear();
+                correction->clear();
+                std::string line = analyse(jobs[i], i, options, tt, *pawnTable, *correction, t,
+                                           *telemetry);
+                std::lock_guard<std::mutex> lock(mutex);
+                if (options.ordered) {
+                    results[i] = std::move(line);
+                    ready.notify_one();
+                } else {
+                    std::cout << line << std::endl;
+                }
+            }
+        });
+    }
+
+    // Ordered output: flush each result as soon as every earlier one has been written
+    if (options.ordered) {
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            std::string line;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [&]() { return results[i].has_value(); });
+                line = std::move(*results[i]);
+                results[i].reset();
+            }
+            std::cout << line << std::endl;
+        }
+    }
+
+    for (auto& w : workers)
+        w.join();
+
+    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::steady_clock::now() - wallStart)
+                         .count();
+    double perSecond = elapsedMs > 0 ? 1000.0 * static_cast<double>(jobs.size()) /
+                                           static_cast<double>(elapsedMs)
+                                     : 0.0;
+    telemetry->write({{"type", "analysis_summary"},
+                      {"input", options.inputPath},
+                      {"positions", jobs.size()},
+                      {"threads", threadCount},
+                      {"time_ms", elapsedMs},
+                      {"positions_per_s", perSecond}});
+    std::cerr << "analyse: done in " << elapsedMs << " ms (" << perSecond << " positions/s)\n";
+    return 0;
+}
+
+}  // namespace cchess
@@ -0,0 +1,59 @@
+#ifndef CCHESS_BATCH_ANALYSIS_H
+#define CCHESS_BATCH_ANALYSIS_H
+
+#include "ai/TranspositionTable.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace cchess {
+
+// One position to analyse. gameHistory holds the hashes of the positions that
+// preceded it in its game (PGN input) so repetition detection matches the game.
+struct AnalysisJob {
+    std::string id;  // EPD "id" opcode, or "game N ply P" for PGN input
+    std::string fen;
+    std::vector<uint64_t> gameHistory;
+};
+
+struct BatchAnalysisOptions {
+    std::string inputPath;  // .epd or .pgn
+    int depth = 0;          // 0 = no depth limit (requires nodes)
+    uint64_t nodes = 0;     // 0 = no node limit (requires depth)
+    int threads = 1;        // worker threads
+    size_t hashMB = TranspositionTable::DEFAULT_WORKER_SIZE_MB;  // table size per worker
+    bool ordered = true;    // emit results in input order instead of completion order
+    std::string affinity;   // worker CPU placement: "auto" or a CPU list (see Affinity.h)
+    std::string telemetryPath;  // JSONL search stats per position (see Telemetry.h); empty = off
+};
+
+// Non-interactive batch analysis over an EPD or PGN file.
+// Usage: cchess --analyse <file.epd|file.pgn> [--depth D] [--nodes N] [--threads T]
+//                         [--hash MB] [--unordered] [--affinity auto|<cpu-list>]
+//                         [--telemetry <file.jsonl>]
+//
+// Positions are distributed over T worker threads, each with its own
+// transposition and pawn tables (allocated after the worker is pinned, so they
+// are local to its NUMA node). The TT and correction history are cleared before
+// each position, so results do not depend on the thread count. Every result is
+// written to stdout as one JSON object per line (score, best move, PV, nodes).
+// Errors and progress go to stderr so stdout stays machine-readable. With
+// --telemetry, each position's search statistics (NPS, TT fill and hit rate,
+// worker) and a run summary are appended to a separate JSONL file.
+class BatchAnalysis {
+public:
+    // Returns a process exit code (0 on success).
+    static int run(const BatchAnalysisOptions& options);
+
+    // Input parsers, exposed for testing. Malformed EPD lines are skipped; a PGN
+    // game stops at the first move that cannot be parsed.
+    static std::vector<AnalysisJob> parseEpd(std::istream& in);
+    static std::vector<AnalysisJob> parsePgn(std::istream& in);
+};
+
+}  // namespace cchess
+
+#endif  // CCHESS_BATCH_ANALYSIS_H
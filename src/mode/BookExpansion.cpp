@@ -0,0 +1,318 @@
+#include "mode/BookExpansion.h"
+
+#include "ai/Eval.h"
+#include "ai/Search.h"
+#include "ai/SearchConfig.h"
+#include "ai/TranspositionTable.h"
+#include "book/PolyglotBook.h"
+#include "core/MoveList.h"
+#include "utils/Affinity.h"
+#include "utils/Error.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <thread>
+
+namespace cchess {
+
+namespace {
+
+// Node limits bound every search; the time limit only has to be out of the way.
+constexpr std::chrono::milliseconds kNoTimeLimit = std::chrono::hours(24);
+constexpr int kCheckpointVersion = 1;
+
+int bestScore(const std::vector<BookNode::ScoredMove>& moves) {
+    int best = -eval::SCORE_MATE;
+    for (const auto& m : moves)
+        best = std::max(best, m.score);
+    return best;
+}
+
+std::optional<Move> legalMoveFromUci(const Board& board, const std::string& uci) {
+    auto parsed = Move::fromAlgebraic(uci);
+    if (!parsed)
+        return std::nullopt;
+    PieceType promo = parsed->isPromotion() ? parsed->promotion() : PieceType::None;
+    return board.findLegalMove(parsed->from(), parsed->to(), promo);
+}
+
+}  // namespace
+
+BookExpansion::BookExpansion(const BookExpansionOptions& options) : options_(options) {
+    if (options_.checkpointPath.empty())
+        options_.checkpointPath = options_.bookPath + ".json";
+}
+
+void BookExpansion::addRoot(const std::string& fen) {
+    Board board(fen);
+    BookNode root;
+    root.fen = board.toFen();
+    nodes_[book::computePolyglotKey(board.position())] = std::move(root);
+}
+
+// Scores every legal move of the position by searching the position after it;
+// moves are handed out to the workers one at a time.
+std::vector<BookNode::ScoredMove> BookExpansion::scoreMoves(const Board& board) const {
+    MoveList moves = board.getLegalMoves();
+    std::vector<BookNode::ScoredMove> scored(moves.size());
+    ThreadPlacement placement = ThreadPlacement::parse(options_.affinity);
+
+    std::atomic<size_t> next{0};
+    auto worker = [&](size_t index) {
+        placement.pinCurrentThread(index);
+        TranspositionTable tt(options_.hashMB);
+        auto pawnTable = std::make_unique<eval::PawnTable>();
+        auto correction = std::make_unique<CorrectionHistory>();
+
+        for (size_t i = next.fetch_add(1); i < moves.size(); i = next.fetch_add(1)) {
+            Board child = board;
+            child.makeMoveUnchecked(moves[i]);
+            scored[i].uci = moves[i].toAlgebraic();
+
+            if (child.isCheckmate()) {
+                scored[i].score = eval::SCORE_MATE - 1;
+                continue;
+            }
+            if (child.isStalemate() || child.isDraw()) {
+                scored[i].score = 0;
+                continue;
+            }
+
+            // Fresh tables per move, so a score does not depend on which moves
+            // this worker happened to score before it
+            tt.clear();
+            correction->clear();
+            SearchConfig config;
+            config.searchTime = kNoTimeLimit;
+            config.maxNodes = options_.nodes;
+            SearchInfo lastInfo{};
+            Search search(child, config, tt, *pawnTable, *correction,
+                          [&lastInfo](const SearchInfo& info) { lastInfo = info; });
+            search.findBestMove();
+            scored[i].score = -lastInfo.score;
+        }
+    };
+
+    size_t threadCount = static_cast<size_t>(std::max(1, options_.threads));
+    threadCount = std::min(threadCount, std::max<size_t>(1, moves.size()));
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < threadCount; ++t)
+        workers.emplace_back(worker, t);
+    worker(0);
+    for (auto& w : workers)
+        w.join();
+    return scored;
+}
+
+const BookNode* BookExpansion::expandNext() {
+    auto pick = nodes_.end();
+    for (auto it = nodes_.begin(); it != nodes_.end(); ++it) {
+        const BookNode& node = it->second;
+        if (node.expanded || node.ply >= options_.maxPly)
+            continue;
+        if (pick == nodes_.end() || node.cost < pick->second.cost)
+            pick = it;
+    }
+    if (pick == nodes_.end())
+        return nullptr;
+
+    BookNode& node = pick->second;
+    Board board(node.fen);
+    node.moves = scoreMoves(board);
+    node.expanded = true;
+
+    const int best = bestScore(node.moves);
+    for (const auto& m : node.moves) {
+        int loss = best - m.score;
+        if (loss > options_.maxLoss)
+            continue;
+        auto move = legalMoveFromUci(board, m.uci);
+        if (!move)
+            continue;
+        Board child = board;
+        child.makeMoveUnchecked(*move);
+        if (child.getLegalMoves().empty())
+            continue;  // mate or stalemate: nothing to book
+
+        uint64_t key = book::computePolyglotKey(child.position());
+        int cost = node.cost + options_.plyCost + loss;
+        auto [it, inserted] = nodes_.try_emplace(key);
+        BookNode& target = it->second;
+        if (inserted) {
+            target.fen = child.toFen();
+            target.ply = node.ply + 1;
+            target.cost = cost;
+        } else {
+            // A transposition: keep the cheapest way in
+            target.cost = std::min(target.cost, cost);
+            target.ply = std::min(target.ply, node.ply + 1);
+        }
+    }
+    return &node;
+}
+
+size_t BookExpansion::writeBook() const {
+    // Positions this tree has analysed replace their entries in the existing
+    // book; every other entry is kept, so a run grows the book it is given.
+    std::vector<book::BookEntry> entries;
+    for (const book::BookEntry& e : book::readPolyglotBook(options_.bookPath)) {
+        auto node = nodes_.find(e.key);
+        if (node == nodes_.end() || !node->second.expanded)
+            entries.push_back(e);
+    }
+
+    for (const auto& [key, node] : nodes_) {
+        if (!node.expanded || node.moves.empty())
+            continue;
+        Board board(node.fen);
+        const int best = bestScore(node.moves);
+        for (const auto& m : node.moves) {
+            int loss = best - m.score;
+            auto move = legalMoveFromUci(board, m.uci);
+            if (loss > options_.maxLoss || !move)
+                continue;
+            book::BookEntry e{};
+            e.key = key;
+            e.move = book::encodePolyglotMove(*move);
+            e.weight = static_cast<uint16_t>(std::clamp(options_.maxLoss + 1 - loss, 1, 65535));
+            entries.push_back(e);
+        }
+    }
+
+    std::filesystem::path parent = std::filesystem::path(options_.bookPath).parent_path();
+    if (!parent.empty())
+        std::filesystem::create_directories(parent);
+    // Written aside and renamed, so an interrupted write keeps the old book
+    std::string tmpPath = options_.bookPath + ".tmp";
+    std::error_code ec;
+    if (!book::writePolyglotBook(tmpPath, entries))
+        throw ChessError("Cannot write book: " + tmpPath);
+    std::filesystem::rename(tmpPath, options_.bookPath, ec);
+    if (ec)
+        throw ChessError("Cannot write book: " + options_.bookPath + ": " + ec.message());
+    return entries.size();
+}
+
+bool BookExpansion::saveCheckpoint() const {
+    nlohmann::json out;
+    out["version"] = kCheckpointVersion;
+    nlohmann::json nodes = nlohmann::json::array();
+    for (const auto& [key, node] : nodes_) {
+        nlohmann::json moves = nlohmann::json::array();
+        for (const auto& m : node.moves)
+            moves.push_back({m.uci, m.score});
+        nodes.push_back({{"fen", node.fen},
+                         {"ply", node.ply},
+                         {"cost", node.cost},
+                         {"expanded", node.expanded},
+                         {"moves", std::move(moves)}});
+    }
+    out["nodes"] = std::move(nodes);
+
+    // Written aside and renamed, so an interrupted write keeps the old checkpoint
+    std::string tmpPath = options_.checkpointPath + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::trunc);
+        if (!file)
+            return false;
+        file << out.dump() << "\n";
+        if (!file)
+            return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, options_.checkpointPath, ec);
+    return !ec;
+}
+
+bool BookExpansion::loadCheckpoint() {
+    std::ifstream file(options_.checkpointPath);
+    if (!file.is_open())
+        return false;
+
+    std::map<uint64_t, BookNode> loaded;
+    try {
+        nlohmann::json in = nlohmann::json::parse(file);
+        if (in.at("version").get<int>() != kCheckpointVersion)
+            throw ChessError("Unsupported checkpoint version in " + options_.checkpointPath);
+        for (const auto& entry : in.at("nodes")) {
+            BookNode node;
+            node.fen = entry.at("fen").get<std::string>();
+            node.ply = entry.at("ply").get<int>();
+            node.cost = entry.at("cost").get<int>();
+            node.expanded = entry.at("expanded").get<bool>();
+            for (const auto& m : entry.at("moves"))
+                node.moves.push_back({m.at(0).get<std::string>(), m.at(1).get<int>()});
+            Board board(node.fen);
+            loaded[book::computePolyglotKey(board.position())] = std::move(node);
+        }
+    } catch (const nlohmann::json::exception& e) {
+        throw ChessError("Corrupt checkpoint " + options_.checkpointPath + ": " + e.what());
+    }
+    nodes_ = std::move(loaded);
+    return true;
+}
+
+int BookExpansion::run() {
+    try {
+        ThreadPlacement::parse(options_.affinity);
+        if (loadCheckpoint()) {
+            size_t expanded = static_cast<size_t>(
+                std::count_if(nodes_.begin(), nodes_.end(),
+                              [](const auto& kv) { return kv.second.expanded; }));
+            std::cout << "Resuming from " << options_.checkpointPath << ": " << nodes_.size()
+                      << " positions, " << expanded << " expanded\n";
+        } else {
+            addRoot(options_.rootFen);
+        }
+    } catch (const ChessError& e) {
+        std::cerr << "expand-book: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "Expanding " << options_.expansions << " positions, " << options_.nodes
+              << " nodes per move, " << options_.threads << " thread(s)\n";
+
+    auto start = std::chrono::steady_clock::now();
+    int done = 0;
+    try {
+        for (; done < options_.expansions; ++done) {
+            const BookNode* node = expandNext();
+            if (!node) {
+                std::cout << "No position left to expand (max ply " << options_.maxPly << ")\n";
+                break;
+            }
+            if (!saveCheckpoint())
+                std::cerr << "expand-book: cannot write " << options_.checkpointPath << "\n";
+            size_t entries = writeBook();
+            auto best = std::max_element(
+                node->moves.begin(), node->moves.end(),
+                [](const auto& a, const auto& b) { return a.score < b.score; });
+            std::cout << "[" << (done + 1) << "/" << options_.expansions << "] ply " << node->ply
+                      << " cost " << node->cost << "  " << node->fen;
+            if (best != node->moves.end())
+                std::cout << "  best " << best->uci << " (" << best->score << ")";
+            std::cout << "  |  " << nodes_.size() << " positions, " << entries
+                      << " book moves\n";
+        }
+    } catch (const ChessError& e) {
+        std::cerr << "expand-book: " << e.what() << "\n";
+        return 1;
+    }
+
+    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    std::cout << "Expanded " << done << " positions in " << elapsedMs / 1000 << "s; book "
+              << options_.bookPath << ", checkpoint " << options_.checkpointPath << "\n";
+    return 0;
+}
+
+}  // namespace cchess
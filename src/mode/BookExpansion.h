@@ -0,0 +1,89 @@
+#ifndef CCHESS_BOOK_EXPANSION_H
+#define CCHESS_BOOK_EXPANSION_H
+
+#include "core/Board.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace cchess {
+
+struct BookExpansionOptions {
+    std::string bookPath = "engines/book.bin";  // Polyglot output
+    std::string checkpointPath;                 // empty = bookPath + ".json"
+    std::string rootFen = Board::STARTING_FEN;  // ignored when resuming
+    int expansions = 50;    // positions to expand in this run
+    uint64_t nodes = 50000;  // per scored move
+    int threads = 1;
+    size_t hashMB = 16;      // per worker
+    int maxPly = 16;         // positions this deep are never expanded
+    int maxLoss = 40;        // centipawns; worse moves stay out of the book
+    int plyCost = 10;        // centipawns of priority per ply of depth
+    std::string affinity;    // worker CPU placement (see Affinity.h)
+};
+
+// One book position, keyed by its Polyglot key so transpositions share a node.
+struct BookNode {
+    struct ScoredMove {
+        std::string uci;
+        int score = 0;  // centipawns for the side to move
+    };
+
+    std::string fen;
+    int ply = 0;
+    int cost = 0;           // drop-out priority: lower is expanded first
+    bool expanded = false;
+    std::vector<ScoredMove> moves;  // every legal move, once expanded
+};
+
+// Grows a Polyglot opening book from CChess's own analysis by drop-out
+// expansion.
+//
+// Every book position has a cost: plyCost per ply from the root plus, along the
+// cheapest path to it, how many centipawns each move loses against the best move
+// of its position. The cheapest unexpanded position is expanded next: all of its
+// legal moves are scored with a fixed-node search, spread over the worker
+// threads, and the moves within maxLoss of the best become new book positions.
+// The main lines are therefore deepened first, and sidelines "drop out" once
+// they are too far behind, instead of the tree growing breadth-first.
+//
+// After each expansion the tree is written to a JSON checkpoint and the book is
+// rewritten, so an interrupted run resumes from the checkpoint. Book weights
+// favour the best move: maxLoss + 1 - loss for every move within maxLoss.
+class BookExpansion {
+public:
+    explicit BookExpansion(const BookExpansionOptions& options);
+
+    // Loads the checkpoint if there is one (else starts from rootFen), expands,
+    // and writes the book. Returns a process exit code.
+    int run();
+
+    void addRoot(const std::string& fen);
+
+    // Expands the cheapest unexpanded position and returns it, or nullptr when
+    // none is left.
+    const BookNode* expandNext();
+
+    // Writes the book from every expanded position, keeping the entries of any
+    // other position already in the book, and returns its number of entries.
+    // Throws ChessError if the file cannot be written.
+    size_t writeBook() const;
+
+    bool loadCheckpoint();
+    bool saveCheckpoint() const;
+
+    const std::map<uint64_t, BookNode>& nodes() const { return nodes_; }
+
+private:
+    std::vector<BookNode::ScoredMove> scoreMoves(const Board& board) const;
+
+    BookExpansionOptions options_;
+    std::map<uint64_t, BookNode> nodes_;  // by Polyglot key
+};
+
+}  // namespace cchess
+
+#endif  // CCHESS_BOOK_EXPANSION_H
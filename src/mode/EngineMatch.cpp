@@ -8,7 +8,9 @@
 #include "core/Move.h"
 #include "core/Notation.h"
 #include "display/BoardRenderer.h"
+#include "mode/Telemetry.h"
 #include "uci/UciEngine.h"
+#include "utils/Error.h"
 
 #include <algorithm>
 #include <chrono>
@@ -18,6 +20,8 @@
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <nlohmann/json.hpp>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -26,6 +30,12 @@ namespace cchess {
 
 namespace {
 
+// Move log capacity reserved per game; longer games grow it as usual
+constexpr size_t MAX_GAME_PLIES_RESERVED = 512;
+
+// TT clusters sampled for the per-move fill in telemetry (microseconds, after the clock stops)
+constexpr size_t TELEMETRY_TT_SAMPLE = 1024;
+
 std::string formatScore(int score) {
     if (score >= eval::SCORE_MATE - 200) {
         int matePly = eval::SCORE_MATE - score;
@@ -88,12 +98,22 @@ std::string timestamp(const char* fmt) {
 // ---------------------------------------------------------------------------
 
 EngineMatch::EngineMatch(const Opponent& opponent, int timeMs, int incMs,
-                         const std::string& bookPath)
-    : opponent_(opponent), timeMs_(timeMs), incMs_(incMs) {
+                         const std::string& bookPath, const AdjudicationConfig& adjudication,
+                         const std::string& telemetryPath)
+    : opponent_(opponent), timeMs_(timeMs), incMs_(incMs), adjudication_(adjudication) {
     if (!bookPath.empty() && !book_.load(bookPath))
         std::cerr << "Warning: could not load book file: " << bookPath << "\n";
+    if (!telemetryPath.empty()) {
+        try {
+            telemetry_ = std::make_unique<TelemetryWriter>(telemetryPath);
+        } catch (const ChessError& e) {
+            std::cerr << "Warning: " << e.what() << "\n";
+        }
+    }
 }
 
+EngineMatch::~EngineMatch() = default;
+
 int EngineMatch::allocateTime(int remainingMs, int incMs) const {
     int allocated = remainingMs / 30 + incMs;
     allocated = std::min(allocated, remainingMs / 3);
@@ -105,8 +125,10 @@ int EngineMatch::allocateTime(int remainingMs, int incMs) const {
 // ---------------------------------------------------------------------------
 
 GameResult EngineMatch::playGame(Color cchessColor, int gameNumber) {
+    auto gameStart = std::chrono::steady_clock::now();
     Board board;
     std::vector<MoveRecord> log;
+    log.reserve(MAX_GAME_PLIES_RESERVED);
 
     const std::string cchessSide = (cchessColor == Color::White) ? "White" : "Black";
     const std::string oppSide = (cchessColor == Color::White) ? "Black" : "White";
@@ -114,6 +136,11 @@ GameResult EngineMatch::playGame(Color cchessColor, int gameNumber) {
     std::cout << "\n=== Game " << gameNumber << ": CChess(" << cchessSide << ") vs "
               << opponent_.name << "(" << oppSide << ") ===\n";
     std::cout << "Time control: " << timeMs_ / 1000 << "+" << incMs_ / 1000 << "\n";
+    if (adjudication_.enabled)
+        std::cout << "Adjudication: resign " << adjudication_.resignScore << "cp x"
+                  << adjudication_.resignMoves << ", draw " << adjudication_.drawScore << "cp x"
+                  << adjudication_.drawMoves << " from move " << adjudication_.drawMoveNumber
+                  << "\n";
     if (!opponent_.options.empty()) {
         std::cout << "Opponent options:";
         for (const auto& [name, value] : opponent_.options)
@@ -130,11 +157,16 @@ GameResult EngineMatch::playGame(Color cchessColor, int gameNumber) {
 
     TranspositionTable tt;
     auto pawnTable = std::make_unique<eval::PawnTable>();
+    auto correction = std::make_unique<CorrectionHistory>();
     std::vector<std::string> moveHistory;
+    std::vector<uint64_t> positionHashes = {board.position().hash()};
+    Adjudicator adjudicator(adjudication_);
+    Adjudication verdict = Adjudication::None;
 
     int wtime = timeMs_;
     int btime = timeMs_;
     std::string resultStr;
+    std::string adjudication;
     int score = 0;
     bool aborted = false;
 
@@ -166,6 +198,31 @@ GameResult EngineMatch::playGame(Color cchessColor, int gameNumber) {
             score = 0;
             break;
         }
+        if (isThreefoldRepetition(positionHashes, board.halfmoveClock())) {
+            std::cout << "\n*** DRAW (threefold repetition) ***\n";
+            resultStr = "Draw by threefold repetition";
+            adjudication = "repetition";
+            score = 0;
+            break;
+        }
+        if (verdict == Adjudication::Draw) {
+            std::cout << "\n*** DRAW by adjudication ***\n";
+            resultStr = "Draw by adjudication";
+            adjudication = "draw";
+            score = 0;
+            break;
+        }
+        if (verdict != Adjudication::None) {
+            Color winner = (verdict == Adjudication::WhiteWins) ? Color::White : Color::Black;
+            bool cchessWon = (winner == cchessColor);
+            std::cout << "\n*** " << (cchessWon ? "CChess" : opponent_.name)
+                      << " wins by adjudication ***\n";
+            resultStr = cchessWon ? "CChess (" + cchessSide + ") wins by adjudication"
+                                  : opponent_.name + " (" + oppSide + ") wins by adjudication";
+            adjudication = "resign";
+            score = cchessWon ? 1 : -1;
+            break;
+        }
         if (board.isInCheck())
             std::cout << ">>> CHECK! <<<\n";
 
@@ -173,6 +230,7 @@ GameResult EngineMatch::playGame(Color cchessColor, int gameNumber) {
         int moveNumber = board.fullmoveNumber();
         bool isCChessTurn = (board.sideToMove() == cchessColor);
         std::string moveUci;
+        std::optional<int> moverScore;  // side-to-move relative, for adjudication
 
         if (isCChessTurn) {
             // Opening book probe — only within the first kBookDepth moves
@@ -202,8 +260,11 @@ GameResult EngineMatch::playGame(Color cchessColor, int gameNumber) {
                             rec.uci = moveUci;
                             rec.side = cchessColor;
                             rec.timeMs = static_cast<int>(elapsed);
+                            rec.clockMs = ourTime;
                             rec.hasCChessInfo = false;  // no search info for book moves
                             log.push_back(std::move(rec));
+                            recordMove(gameNumber, static_cast<int>(log.size()), true, log.back(),
+                                       tt);
 
                             std::cout << "\nCChess: " << san << " (" << moveUci << ") [book]\n";
                             usedBook = true;
@@ -215,11 +276,12 @@ GameResult EngineMatch::playGame(Color cchessColor, int gameNumber) {
 
             if (!usedBook) {
                 int remaining = (cchessColor == Color::White) ? wtime : btime;
+                int allocatedMs = allocateTime(remaining, incMs_);
                 SearchConfig config;
-                config.searchTime = std::chrono::milliseconds(allocateTime(remaining, incMs_));
+                config.searchTime = std::chrono::milliseconds(allocatedMs);
 
                 SearchInfo lastInfo{};
-                Search search(board, config, tt, *pawnTable,
+                Search search(board, config, tt, *pawnTable, *correction,
                               [&lastInfo](const SearchInfo& i) { lastInfo = i; });
                 Move best = search.findBestMove();
                 uint64_t totalNodes = search.totalNodes();
@@ -248,10 +310,15 @@ GameResult EngineMatch::playGame(Color cchessColor, int gameNumber) {
                 rec.score = lastInfo.score;
                 rec.nodes = totalNodes;
                 rec.timeMs = static_cast<int>(elapsed);
+                rec.allocatedMs = allocatedMs;
+                rec.clockMs = ourTime;
                 rec.nps = nps;
-                rec.pv = lastInfo.pv;
+                rec.pvLength = std::min(lastInfo.pv.size(), MoveRecord::PV_MOVES);
+                std::copy_n(lastInfo.pv.begin(), rec.pvLength, rec.pv.begin());
                 rec.hasCChessInfo = true;
                 log.push_back(std::move(rec));
+                recordMove(gameNumber, static_cast<int>(log.size()), true, log.back(), tt);
+                moverScore = lastInfo.score;
 
                 std::cout << "\nCChess: " << san << " (" << moveUci << ")"
                           << " | depth " << lastInfo.depth << " | score "
@@ -328,8 +395,13 @@ GameResult EngineMatch::playGame(Color cchessColor, int gameNumber) {
             rec.uci = moveUci;
             rec.side = ~cchessColor;
             rec.timeMs = static_cast<int>(elapsed);
+            rec.clockMs = oppTime;
             rec.hasCChessInfo = false;
+            moverScore = engine.lastScore();
+            rec.hasScore = moverScore.has_value();
+            rec.score = moverScore.value_or(0);
             log.push_back(std::move(rec));
+            recordMove(gameNumber, static_cast<int>(log.size()), false, log.back(), tt);
 
             std::cout << "\n"
                       << opponent_.name << ": " << san << " (" << moveUci << ") [" << elapsed
@@ -344,6 +416,13 @@ GameResult EngineMatch::playGame(Color cchessColor, int gameNumber) {
         }
 
         moveHistory.push_back(moveUci);
+        positionHashes.push_back(board.position().hash());
+
+        Color mover = ~board.sideToMove();
+        std::optional<int> whiteScore;
+        if (moverScore)
+            whiteScore = (mover == Color::White) ? *moverScore : -*moverScore;
+        verdict = adjudicator.update(mover, moveNumber, whiteScore);
     }
 
     auto summary = GameSummary::fromLog(log);
@@ -352,6 +431,8 @@ GameResult EngineMatch::playGame(Color cchessColor, int gameNumber) {
     std::cout << "\n--- Game " << gameNumber << " summary ---\n";
     std::cout << "Result: " << resultStr << "\n";
     std::cout << "Total moves: " << log.size() << "\n";
+    if (!adjudication.empty())
+        std::cout << "Adjudicated: " << adjudication << " after " << log.size() << " plies\n";
     if (summary.cchessMoves > 0) {
         std::cout << "CChess nodes: " << commaNumber(summary.totalNodes) << "\n";
         std::cout << "CChess avg depth: " << std::fixed << std::setprecision(1)
@@ -366,6 +447,8 @@ GameResult EngineMatch::playGame(Color cchessColor, int gameNumber) {
     std::cout << "TT hit rate: " << ttStats.hitRate() << "%  "
               << "cutoff: " << ttStats.cutoffRate() << "%  "
               << "occupancy: " << tt.occupancy() << "%\n";
+    TTDiagnostics ttDiagnostics = tt.sample();
+    ttDiagnostics.print(std::cout);
 
     GameResult result;
     result.resultStr = resultStr;
@@ -373,11 +456,18 @@ GameResult EngineMatch::playGame(Color cchessColor, int gameNumber) {
     result.aborted = aborted;
     result.cchessColor = cchessColor;
     result.gameNumber = gameNumber;
+    result.adjudication = adjudication;
+    result.plies = static_cast<int>(log.size());
+    result.durationMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::steady_clock::now() - gameStart)
+                            .count();
     result.summary = summary;
     result.ttStats = ttStats;
     result.ttOccupancy = tt.occupancy();
+    result.ttDiagnostics = ttDiagnostics;
 
     writeGameReport(result, log);
+    recordGame(result);
     return result;
 }
 
@@ -388,6 +478,7 @@ GameResult EngineMatch::playGame(Color cchessColor, int gameNumber) {
 void EngineMatch::playSeries() {
     const std::vector<Color> sides = {Color::White, Color::Black, Color::White};
 
+    matchId_ = opponent_.name + "_" + timestamp("%Y%m%d_%H%M%S");
     std::cout << "\n=== Engine Match: CChess vs " << opponent_.name << " ===\n";
     std::cout << "3 games  |  " << timeMs_ / 1000 << "+" << incMs_ / 1000 << "  |  CChess: W B W\n";
 
@@ -438,7 +529,109 @@ void EngineMatch::playSeries() {
         }
     }
 
+    int resigned = 0, adjudicatedDraws = 0, repetitions = 0, totalPlies = 0;
+    int64_t totalMs = 0;
+    for (const auto& r : results) {
+        resigned += r.adjudication == "resign";
+        adjudicatedDraws += r.adjudication == "draw";
+        repetitions += r.adjudication == "repetition";
+        totalPlies += r.plies;
+        totalMs += r.durationMs;
+    }
+    std::cout << "\nAdjudicated: " << resigned << " resign, " << adjudicatedDraws << " draw, "
+              << repetitions << " repetition  |  avg length "
+              << totalPlies / static_cast<int>(results.size()) << " plies  |  "
+              << std::fixed << std::setprecision(1)
+              << (totalMs > 0 ? 3600000.0 * static_cast<double>(results.size()) /
+                                    static_cast<double>(totalMs)
+                              : 0.0)
+              << " games/hour\n";
+
     appendSeriesRecord(results);
+
+    if (telemetry_) {
+        telemetry_->write({{"type", "series"},
+                           {"match", matchId_},
+                           {"opponent", opponent_.name},
+                           {"time_control_ms", {timeMs_, incMs_}},
+                           {"games", results.size()},
+                           {"wins", wins},
+                           {"draws", draws},
+                           {"losses", losses},
+                           {"adjudicated", {{"resign", resigned},
+                                            {"draw", adjudicatedDraws},
+                                            {"repetition", repetitions}}},
+                           {"duration_ms", totalMs}});
+        telemetry_->flush();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Telemetry
+// ---------------------------------------------------------------------------
+
+// Scores are from the mover's point of view; null when the move has none (book
+// moves, an opponent that reports no score).
+void EngineMatch::recordMove(int gameNumber, int ply, bool byCChess, const MoveRecord& rec,
+                             const TranspositionTable& tt) const {
+    if (!telemetry_)
+        return;
+    nlohmann::json out = {{"type", "move"},
+                          {"match", matchId_},
+                          {"game", gameNumber},
+                          {"ply", ply},
+                          {"move_number", rec.moveNumber},
+                          {"side", rec.side == Color::White ? "white" : "black"},
+                          {"engine", byCChess ? "CChess" : opponent_.name},
+                          {"uci", rec.uci},
+                          {"san", rec.san},
+                          {"time_ms", rec.timeMs},
+                          {"clock_ms", rec.clockMs}};
+    out["score"] = (rec.hasCChessInfo || rec.hasScore) ? nlohmann::json(rec.score) : nullptr;
+    if (byCChess) {
+        out["source"] = rec.hasCChessInfo ? "search" : "book";
+        if (rec.hasCChessInfo) {
+            out["depth"] = rec.depthReached;
+            out["nodes"] = rec.nodes;
+            out["nps"] = rec.nps;
+            out["allocated_ms"] = rec.allocatedMs;
+        }
+        TTDiagnostics sample = tt.sample(TELEMETRY_TT_SAMPLE);
+        out["tt_fill_permille"] =
+            sample.sampledSlots() ? sample.usedSlots() * 1000 / sample.sampledSlots() : 0;
+        out["game_tt_hit_rate"] = tt.stats().hitRate();  // cumulative over the game
+    }
+    telemetry_->write(std::move(out));
+}
+
+void EngineMatch::recordGame(const GameResult& result) const {
+    if (!telemetry_)
+        return;
+    const GameSummary& s = result.summary;
+    nlohmann::json out = {{"type", "game"},
+                          {"match", matchId_},
+                          {"game", result.gameNumber},
+                          {"opponent", opponent_.name},
+                          {"cchess_color", result.cchessColor == Color::White ? "white" : "black"},
+                          {"result", result.resultStr},
+                          {"score", result.score},
+                          {"aborted", result.aborted},
+                          {"plies", result.plies},
+                          {"duration_ms", result.durationMs},
+                          {"cchess_moves", s.cchessMoves},
+                          {"nodes", s.totalNodes},
+                          {"time_ms", s.totalTimeMs}};
+    out["adjudication"] = result.adjudication.empty() ? nlohmann::json(nullptr)
+                                                      : nlohmann::json(result.adjudication);
+    if (s.cchessMoves > 0) {
+        out["avg_depth"] = static_cast<double>(s.totalDepth) / s.cchessMoves;
+        out["avg_nps"] = s.totalNps / static_cast<uint64_t>(s.cchessMoves);
+    }
+    out["tt"] = {{"probes", result.ttStats.probes},
+                 {"hit_rate", result.ttStats.hitRate()},
+                 {"cutoff_rate", result.ttStats.cutoffRate()},
+                 {"occupancy", result.ttOccupancy}};
+    telemetry_->write(std::move(out));
 }
 
 // ---------------------------------------------------------------------------
@@ -464,6 +657,10 @@ void EngineMatch::writeGameReport(const GameResult& result,
     out << "**CChess plays:** " << cchessSide << "\n";
     out << "**Opponent plays:** " << oppSide << "\n";
     out << "**Result:** " << result.resultStr << "\n";
+    if (!result.adjudication.empty())
+        out << "**Adjudicated:** " << result.adjudication << " after " << result.plies
+            << " plies\n";
+    out << "**Duration:** " << result.durationMs / 1000 << "s\n";
 
     if (!opponent_.options.empty()) {
         out << "\n### Opponent UCI Options\n\n";
@@ -481,19 +678,19 @@ void EngineMatch::writeGameReport(const GameResult& result,
             std::to_string(rec.moveNumber) + (rec.side == Color::White ? "." : "...");
         if (rec.hasCChessInfo) {
             std::string pvStr;
-            int pvCount = std::min(static_cast<int>(rec.pv.size()), 5);
-            for (int i = 0; i < pvCount; ++i) {
+            for (size_t i = 0; i < rec.pvLength; ++i) {
                 if (i > 0)
                     pvStr += " ";
-                pvStr += rec.pv[static_cast<size_t>(i)].toAlgebraic();
+                pvStr += rec.pv[i].toAlgebraic();
             }
             out << "| " << label << " | " << rec.san << " | " << rec.depthReached << " | "
                 << formatScore(rec.score) << " | " << compactNumber(rec.nodes) << " | "
                 << rec.timeMs << "ms"
                 << " | " << compactNumber(rec.nps) << " | " << pvStr << " |\n";
         } else {
-            out << "| " << label << " | " << rec.san << " | — | — | — | " << rec.timeMs
-                << "ms | — | — |\n";
+            std::string scoreStr = rec.hasScore ? formatScore(rec.score) : "—";
+            out << "| " << label << " | " << rec.san << " | — | " << scoreStr << " | — | "
+                << rec.timeMs << "ms | — | — |\n";
         }
     }
 
@@ -514,6 +711,10 @@ void EngineMatch::writeGameReport(const GameResult& result,
     out << "| TT Cutoff Rate | " << result.ttStats.cutoffRate() << "% |\n";
     out << "| TT Occupancy | " << result.ttOccupancy << "% |\n";
 
+    out << "\n## TT Diagnostics\n\n```\n";
+    result.ttDiagnostics.print(out);
+    out << "```\n";
+
     std::cout << "Game report saved to: " << filename << "\n";
 
     writePgn(result, log);
@@ -553,6 +754,8 @@ void EngineMatch::writePgn(const GameResult& result, const std::vector<MoveRecor
     out << "[Black \"" << blackName << "\"]\n";
     out << "[Result \"" << pgnResult << "\"]\n";
     out << "[TimeControl \"" << timeMs_ / 1000 << "+" << incMs_ / 1000 << "\"]\n";
+    if (result.adjudication == "resign" || result.adjudication == "draw")
+        out << "[Termination \"adjudication\"]\n";
     // Opponent UCI options as a comment tag
     if (!opponent_.options.empty()) {
         std::string optStr;
@@ -1,20 +1,31 @@
 #ifndef CCHESS_ENGINE_MATCH_H
 #define CCHESS_ENGINE_MATCH_H
 
+#include "ai/TTDiagnostics.h"
 #include "ai/TranspositionTable.h"
 #include "book/PolyglotBook.h"
 #include "core/Board.h"
 #include "core/Move.h"
 #include "core/Types.h"
+#include "mode/Adjudication.h"
 #include "mode/OpponentList.h"
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace cchess {
 
+class TelemetryWriter;
+
+// One played move. Fixed size: san and uci fit std::string's inline buffer and only
+// the leading PV moves are kept, so recording a move does not allocate.
 struct MoveRecord {
+    static constexpr size_t PV_MOVES = 5;  // PV moves shown in the game report
+
     int moveNumber = 0;
     std::string san;
     std::string uci;
@@ -23,9 +34,13 @@ struct MoveRecord {
     int score = 0;  // centipawns, white-relative
     uint64_t nodes = 0;
     int timeMs = 0;
+    int allocatedMs = 0;  // CChess searches: the time the search was given
+    int clockMs = 0;      // mover's clock after the move, increment included
     uint64_t nps = 0;
-    std::vector<Move> pv;
+    std::array<Move, PV_MOVES> pv{};
+    size_t pvLength = 0;
     bool hasCChessInfo = false;  // true for CChess moves, false for opponent
+    bool hasScore = false;       // opponent moves: the engine reported a score
 };
 
 struct GameSummary {
@@ -57,17 +72,25 @@ struct GameResult {
     bool aborted = false;  // true if game ended due to engine error (not counted in series)
     Color cchessColor = Color::White;
     int gameNumber = 0;
+    std::string adjudication;  // "resign", "draw" or "repetition"; empty when played out
+    int plies = 0;
+    int64_t durationMs = 0;
     GameSummary summary;
     TTStats ttStats{};
     double ttOccupancy = 0.0;
+    TTDiagnostics ttDiagnostics;  // sampled at the end of the game
 };
 
 class EngineMatch {
 public:
     // timeMs: base time per side in ms, incMs: increment per move in ms
     // bookPath: optional Polyglot .bin book (empty string = no book)
+    // telemetryPath: optional JSONL file that move, game and series records are appended to
     explicit EngineMatch(const Opponent& opponent, int timeMs = 180000, int incMs = 2000,
-                         const std::string& bookPath = "");
+                         const std::string& bookPath = "",
+                         const AdjudicationConfig& adjudication = {},
+                         const std::string& telemetryPath = "");
+    ~EngineMatch();
 
     void playSeries();
 
@@ -78,11 +101,17 @@ private:
     void writeGameReport(const GameResult& result, const std::vector<MoveRecord>& log) const;
     void writePgn(const GameResult& result, const std::vector<MoveRecord>& log) const;
     void appendSeriesRecord(const std::vector<GameResult>& results) const;
+    void recordMove(int gameNumber, int ply, bool byCChess, const MoveRecord& rec,
+                    const TranspositionTable& tt) const;
+    void recordGame(const GameResult& result) const;
 
     Opponent opponent_;
     int timeMs_;
     int incMs_;
+    AdjudicationConfig adjudication_;
     book::PolyglotBook book_;
+    std::unique_ptr<TelemetryWriter> telemetry_;  // null when telemetry is off
+    std::string matchId_;                         // tags this series' telemetry records
     static constexpr int kBookDepth = 10;  // stop consulting book after this many moves
 };
 
@@ -0,0 +1,148 @@
+#include "mode/MateRunner.h"
+
+#include "ai/MateSolver.h"
+#include "core/Board.h"
+#include "core/Notation.h"
+#include "utils/Error.h"
+#include "utils/StringUtils.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace cchess {
+
+namespace {
+
+// Value of an EPD opcode such as `dm 3;`, or an empty string.
+std::string opcode(const std::string& line, const std::string& name) {
+    std::istringstream ops(line);
+    std::string token;
+    while (ops >> token) {
+        if (token == name) {
+            std::string value;
+            std::getline(ops, value, ';');
+            return trim(value);
+        }
+    }
+    return {};
+}
+
+}  // namespace
+
+std::vector<MateProblem> MateRunner::parseEpd(std::istream& in) {
+    std::vector<MateProblem> problems;
+    std::string line;
+    int lineNo = 0;
+
+    while (std::getline(in, line)) {
+        ++lineNo;
+        line = trim(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        // Four FEN fields; the move counters are optional
+        std::istringstream ss(line);
+        std::string board, side, castling, ep;
+        if (!(ss >> board >> side >> castling >> ep))
+            continue;
+        std::string halfmove = "0", fullmove = "1";
+        std::string f5, f6;
+        auto afterEp = ss.tellg();
+        if ((ss >> f5 >> f6) && isInteger(f5) && isInteger(f6)) {
+            halfmove = f5;
+            fullmove = f6;
+        } else {
+            ss.clear();
+            ss.seekg(afterEp);
+        }
+        std::string ops;
+        std::getline(ss, ops);
+
+        MateProblem problem;
+        problem.fen =
+            board + " " + side + " " + castling + " " + ep + " " + halfmove + " " + fullmove;
+        try {
+            Board check(problem.fen);
+        } catch (const ChessError&) {
+            continue;
+        }
+
+        std::string dm = opcode(ops, "dm");
+        if (isInteger(dm))
+            problem.expectedMoves = toInteger(dm);
+        std::string id = opcode(ops, "id");
+        if (id.size() >= 2 && id.front() == '"' && id.back() == '"')
+            id = id.substr(1, id.size() - 2);
+        problem.id = id.empty() ? "line " + std::to_string(lineNo) : id;
+
+        problems.push_back(std::move(problem));
+    }
+    return problems;
+}
+
+int MateRunner::run(const MateRunnerOptions& options) {
+    std::ifstream file(options.inputPath);
+    if (!file.is_open()) {
+        std::cerr << "solve-mate: cannot open " << options.inputPath << "\n";
+        return 1;
+    }
+    std::vector<MateProblem> problems = parseEpd(file);
+    if (problems.empty()) {
+        std::cerr << "solve-mate: no positions found in " << options.inputPath << "\n";
+        return 1;
+    }
+
+    MateSolver solver(options.hashMB);
+    MateSolverConfig config;
+    config.timeLimit = std::chrono::milliseconds(options.timeMs);
+
+    std::cout << std::left << std::setw(16) << "id" << std::setw(14) << "result" << std::setw(9)
+              << "move" << std::right << std::setw(12) << "nodes" << std::setw(12) << "nps"
+              << std::setw(10) << "proof" << std::setw(9) << "ms" << "\n";
+
+    size_t solved = 0, mismatched = 0;
+    uint64_t totalNodes = 0, totalProof = 0;
+    int64_t totalMs = 0;
+    for (const auto& problem : problems) {
+        Board board(problem.fen);
+        config.maxMoves = problem.expectedMoves > 0 ? problem.expectedMoves : options.maxMoves;
+        MateResult result = solver.solve(board, config);
+
+        std::string verdict;
+        if (result.found) {
+            verdict = "mate " + std::to_string(result.mateIn);
+            ++solved;
+            totalProof += result.proofSize;
+            if (problem.expectedMoves > 0 && result.mateIn != problem.expectedMoves) {
+                verdict += " (dm " + std::to_string(problem.expectedMoves) + ")";
+                ++mismatched;
+            }
+        } else {
+            verdict = result.disproven ? "no mate" : "unknown";
+        }
+        totalNodes += result.nodes;
+        totalMs += result.timeMs;
+
+        std::string move = result.found ? moveToSan(board, result.bestMove) : "-";
+        std::cout << std::left << std::setw(16) << problem.id << std::setw(14) << verdict
+                  << std::setw(9) << move << std::right << std::setw(12) << result.nodes
+                  << std::setw(12) << result.nps() << std::setw(10)
+                  << (result.found ? std::to_string(result.proofSize) : "-") << std::setw(9)
+                  << result.timeMs << "\n";
+    }
+
+    uint64_t nps = totalMs > 0 ? totalNodes * 1000 / static_cast<uint64_t>(totalMs) : 0;
+    std::cout << "\nSolved " << solved << "/" << problems.size();
+    if (mismatched > 0)
+        std::cout << " (" << mismatched << " differ from dm)";
+    std::cout << ", " << totalNodes << " nodes in " << totalMs << " ms (" << nps << " nps)";
+    if (solved > 0)
+        std::cout << ", mean proof size " << totalProof / solved;
+    std::cout << "\n";
+    return 0;
+}
+
+}  // namespace cchess
@@ -0,0 +1,41 @@
+#ifndef CCHESS_MATE_RUNNER_H
+#define CCHESS_MATE_RUNNER_H
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace cchess {
+
+struct MateProblem {
+    std::string id;  // EPD "id" opcode, or "line N"
+    std::string fen;
+    int expectedMoves = 0;  // EPD "dm" opcode; 0 when absent
+};
+
+struct MateRunnerOptions {
+    std::string inputPath;
+    int maxMoves = 5;    // mate length searched when a position has no "dm" opcode
+    int timeMs = 10000;  // per position
+    size_t hashMB = 64;  // solver table, shared by all positions
+};
+
+// Proves forced mates over an EPD file with the df-pn solver.
+// Usage: cchess --solve-mate <file.epd> [--mate N] [--time MS] [--hash MB]
+//
+// Each position is searched for a mate in up to its "dm" length (or --mate),
+// and one line per position reports the result, the mating move, nodes,
+// nodes per second and proof size, followed by totals.
+class MateRunner {
+public:
+    // Returns a process exit code (0 on success).
+    static int run(const MateRunnerOptions& options);
+
+    // Malformed lines are skipped.
+    static std::vector<MateProblem> parseEpd(std::istream& in);
+};
+
+}  // namespace cchess
+
+#endif  // CCHESS_MATE_RUNNER_H
@@ -0,0 +1,261 @@
+#include "mode/PlayerVsEngine.h"
+
+#include "ai/Eval.h"
+#include "ai/SearchConfig.h"
+#include "core/Notation.h"
+#include "display/BoardRenderer.h"
+#include "utils/StringUtils.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace cchess {
+
+namespace {
+
+constexpr size_t kHashMB = TranspositionTable::DEFAULT_WORKER_SIZE_MB;
+
+std::string formatScore(int score) {
+    if (score >= eval::SCORE_MATE - 200)
+        return "M" + std::to_string((eval::SCORE_MATE - score + 1) / 2);
+    if (score <= -(eval::SCORE_MATE - 200))
+        return "-M" + std::to_string((eval::SCORE_MATE + score + 1) / 2);
+    std::ostringstream oss;
+    oss << std::showpos << std::fixed << std::setprecision(2)
+        << (static_cast<double>(score) / 100.0);
+    return oss.str();
+}
+
+std::string formatSeconds(std::chrono::milliseconds ms) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1) << (static_cast<double>(ms.count()) / 1000.0)
+        << "s";
+    return oss.str();
+}
+
+}  // namespace
+
+PlayerVsEngine::PlayerVsEngine(Color humanColor, std::chrono::milliseconds moveTime, bool ponder,
+                               const std::string& fen)
+    : board_(fen),
+      humanColor_(humanColor),
+      moveTime_(moveTime),
+      ponderEnabled_(ponder),
+      tt_(kHashMB),
+      pawnTable_(std::make_unique<eval::PawnTable>()),
+      correction_(std::make_unique<CorrectionHistory>()) {}
+
+PlayerVsEngine::~PlayerVsEngine() {
+    stopPonder();
+}
+
+void PlayerVsEngine::play() {
+    std::cout << "=== Chess: Player vs Engine ===\n";
+    std::cout << "You play " << (humanColor_ == Color::White ? "White" : "Black")
+              << ". Enter moves as e2e4, e2 e4 or SAN (Nf3, O-O)\n";
+    std::cout << "Engine: " << formatSeconds(moveTime_) << " per move, pondering "
+              << (ponderEnabled_ ? "on" : "off") << "\n";
+    std::cout << "Enter 'quit' to exit\n";
+
+    while (true) {
+        displayBoard();
+        if (isGameOver())
+            break;
+
+        if (board_.isInCheck())
+            std::cout << "\n>>> CHECK! <<<\n";
+
+        if (board_.sideToMove() != humanColor_) {
+            engineTurn();
+            continue;
+        }
+
+        auto move = readHumanMove();
+        if (!move) {
+            std::cout << "Game ended.\n";
+            break;
+        }
+
+        if (ponderThread_.joinable()) {
+            if (*move == ponderMove_) {
+                // Ponder hit: let the running search continue on the clock
+                ponderGained_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - ponderStart_);
+                ponderActive_.store(false);
+                ponderHit_ = true;
+            } else {
+                stopPonder();
+                ++ponderMisses_;
+            }
+        }
+        playMove(*move);
+    }
+
+    stopPonder();
+    if (ponderHits_ + ponderMisses_ > 0) {
+        std::cout << "\nPonder: " << ponderHits_ << " hit(s), " << ponderMisses_
+                  << " miss(es), " << formatSeconds(totalGained_) << " of thinking time gained\n";
+    }
+}
+
+void PlayerVsEngine::displayBoard() const {
+    std::cout << "\n" << BoardRenderer::render(board_) << "\n";
+    std::cout << BoardRenderer::renderPositionInfo(board_);
+}
+
+bool PlayerVsEngine::isGameOver() const {
+    if (board_.isCheckmate()) {
+        Color winner = ~board_.sideToMove();
+        std::cout << "\n*** CHECKMATE! ***\n";
+        std::cout << (winner == humanColor_ ? "You win!" : "Engine wins.") << "\n";
+        return true;
+    }
+    if (board_.isStalemate()) {
+        std::cout << "\n*** STALEMATE! ***\nGame drawn.\n";
+        return true;
+    }
+    if (board_.isDraw()) {
+        std::cout << "\n*** DRAW! ***\n50-move rule: Game drawn.\n";
+        return true;
+    }
+    if (isThreefold()) {
+        std::cout << "\n*** DRAW! ***\nThreefold repetition: Game drawn.\n";
+        return true;
+    }
+    return false;
+}
+
+bool PlayerVsEngine::isThreefold() const {
+    uint64_t hash = board_.position().hash();
+    return std::count(history_.begin(), history_.end(), hash) >= 2;
+}
+
+void PlayerVsEngine::playMove(const Move& move) {
+    history_.push_back(board_.position().hash());
+    board_.makeMoveUnchecked(move);
+}
+
+std::optional<Move> PlayerVsEngine::readHumanMove() {
+    while (true) {
+        std::cout << "\nYour move: ";
+
+        std::string input;
+        if (!std::getline(std::cin, input))
+            return std::nullopt;
+        input = trim(input);
+
+        if (input == "quit" || input == "exit")
+            return std::nullopt;
+        if (input.empty())
+            continue;
+
+        if (auto move = parseMove(board_, input))
+            return move;
+        std::cout << "Illegal or unrecognised move: " << input << "\n";
+    }
+}
+
+std::optional<Move> PlayerVsEngine::parseMove(const Board& board, const std::string& input) {
+    std::string coords;
+    for (char c : input) {
+        if (!std::isspace(static_cast<unsigned char>(c)))
+            coords += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    MoveList moves = board.getLegalMoves();
+    for (const auto& candidate : {coords, coords + "q"}) {
+        for (const auto& move : moves) {
+            if (move.toAlgebraic() == candidate)
+                return move;
+        }
+    }
+    return sanToMove(board, input);
+}
+
+void PlayerVsEngine::engineTurn() {
+    Move best;
+    SearchInfo info;
+    uint64_t nodes = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    if (ponderHit_) {
+        ponderThread_.join();
+        ponderHit_ = false;
+        best = ponderBest_;
+        info = ponderInfo_;
+        nodes = ponderNodes_;
+        ++ponderHits_;
+        totalGained_ += ponderGained_;
+        std::cout << "\nPonder hit: gained " << formatSeconds(ponderGained_)
+                  << " of thinking time\n";
+    } else {
+        std::cout << "\nEngine is thinking...\n";
+        SearchConfig config;
+        config.searchTime = moveTime_;
+        Search search(board_, config, tt_, *pawnTable_, *correction_,
+                      [&info](const SearchInfo& i) { info = i; }, history_);
+        best = search.findBestMove();
+        nodes = search.totalNodes();
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    std::cout << "Engine plays " << moveToSan(board_, best) << " (" << best.toAlgebraic() << ")"
+              << " | depth " << info.depth << " | score " << formatScore(info.score) << " | "
+              << nodes << " nodes | " << elapsed.count() << "ms\n";
+
+    playMove(best);
+
+    // Predicted reply is the second PV move, if it is legal here
+    if (ponderEnabled_ && info.pv.size() >= 2 && !info.pv[0].isNull() && info.pv[0] == best) {
+        MoveList legal = board_.getLegalMoves();
+        if (std::find(legal.begin(), legal.end(), info.pv[1]) != legal.end())
+            startPonder(info.pv[1]);
+    }
+}
+
+void PlayerVsEngine::startPonder(const Move& predicted) {
+    Board ponderBoard = board_;
+    std::vector<uint64_t> ponderHistory = history_;
+    ponderHistory.push_back(ponderBoard.position().hash());
+    ponderBoard.makeMoveUnchecked(predicted);
+
+    // A position that is already over has nothing to ponder
+    if (ponderBoard.getLegalMoves().empty())
+        return;
+
+    ponderMove_ = predicted;
+    ponderStop_.store(false);
+    ponderActive_.store(true);
+    ponderHit_ = false;
+    ponderStart_ = std::chrono::steady_clock::now();
+
+    SearchConfig config;
+    config.searchTime = moveTime_;
+    config.stopSignal = &ponderStop_;
+    config.ponderSignal = &ponderActive_;
+
+    ponderThread_ = std::thread([this, config, ponderBoard,
+                                 ponderHistory = std::move(ponderHistory)]() mutable {
+        SearchInfo last{};
+        Search search(ponderBoard, config, tt_, *pawnTable_, *correction_,
+                      [&last](const SearchInfo& i) { last = i; }, std::move(ponderHistory));
+        ponderBest_ = search.findBestMove();
+        ponderInfo_ = last;
+        ponderNodes_ = search.totalNodes();
+    });
+}
+
+void PlayerVsEngine::stopPonder() {
+    if (!ponderThread_.joinable())
+        return;
+    ponderStop_.store(true);
+    ponderThread_.join();
+    ponderHit_ = false;
+}
+
+}  // namespace cchess
@@ -0,0 +1,91 @@
+#ifndef CCHESS_PLAYER_VS_ENGINE_H
+#define CCHESS_PLAYER_VS_ENGINE_H
+
+#include "ai/CorrectionHistory.h"
+#include "ai/PawnTable.h"
+#include "ai/Search.h"
+#include "ai/TranspositionTable.h"
+#include "core/Board.h"
+#include "core/Move.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cchess {
+
+// Interactive game between a human and the engine.
+//
+// With pondering enabled, after each engine move the engine keeps searching the
+// position after the reply it predicts (the second move of its PV) while the
+// human thinks. If the human plays that move, the same search simply carries on
+// with its clock started from that moment, so the engine keeps everything it
+// learned while waiting; otherwise the ponder search is stopped and a normal
+// search starts on the real position, still benefiting from the warm TT.
+class PlayerVsEngine {
+public:
+    PlayerVsEngine(Color humanColor, std::chrono::milliseconds moveTime, bool ponder = true,
+                   const std::string& fen = Board::STARTING_FEN);
+    ~PlayerVsEngine();
+
+    PlayerVsEngine(const PlayerVsEngine&) = delete;
+    PlayerVsEngine& operator=(const PlayerVsEngine&) = delete;
+
+    // Run the game loop
+    void play();
+
+    // Parses a human move given as coordinates ("e2e4", "e2 e4", "e7e8q") or SAN
+    // ("Nf3", "O-O"). Coordinate promotions without a piece promote to a queen.
+    static std::optional<Move> parseMove(const Board& board, const std::string& input);
+
+private:
+    void displayBoard() const;
+    bool isGameOver() const;  // prints the result when the game has ended
+    bool isThreefold() const;
+    void playMove(const Move& move);
+
+    // Reads moves until a legal one or "quit" (nullopt) is entered
+    std::optional<Move> readHumanMove();
+
+    // Plays the engine's move, using the ponder search on a ponder hit
+    void engineTurn();
+
+    void startPonder(const Move& predicted);
+    void stopPonder();
+
+    Board board_;
+    std::vector<uint64_t> history_;  // hashes of earlier positions, for repetition detection
+    Color humanColor_;
+    std::chrono::milliseconds moveTime_;
+    bool ponderEnabled_;
+
+    TranspositionTable tt_;
+    std::unique_ptr<eval::PawnTable> pawnTable_;
+    std::unique_ptr<CorrectionHistory> correction_;
+
+    // Ponder search state. The ponder thread owns the search; the results below
+    // are only read after it has been joined.
+    std::thread ponderThread_;
+    Move ponderMove_;                                   // predicted human reply
+    std::atomic<bool> ponderStop_{false};               // abandons the search on a miss
+    std::atomic<bool> ponderActive_{false};             // cleared on a hit to start the clock
+    std::chrono::steady_clock::time_point ponderStart_;
+    std::chrono::milliseconds ponderGained_{0};         // ponder time before this move's hit
+    bool ponderHit_ = false;
+    Move ponderBest_;
+    SearchInfo ponderInfo_;
+    uint64_t ponderNodes_ = 0;
+
+    int ponderHits_ = 0;
+    int ponderMisses_ = 0;
+    std::chrono::milliseconds totalGained_{0};
+};
+
+}  // namespace cchess
+
+#endif  // CCHESS_PLAYER_VS_ENGINE_H
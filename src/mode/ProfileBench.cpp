@@ -1,17 +1,31 @@
 #include "ProfileBench.h"
 
+#include "Adjudication.h"
+#include "../ai/InterleavedSearch.h"
 #include "../ai/Search.h"
 #include "../ai/SearchConfig.h"
+#include "../ai/SearchTrace.h"
+#include "../ai/TTDiagnostics.h"
 #include "../ai/TranspositionTable.h"
 #include "../core/Board.h"
+#include "../utils/Affinity.h"
+#include "../utils/CpuFeatures.h"
+#include "../utils/Error.h"
+#include "../utils/MemoryUsage.h"
+#include "../utils/PerfCounters.h"
 
+#include <array>
 #include <chrono>
+#include <cmath>
 #include <filesystem>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <memory>
+#include <nlohmann/json.hpp>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace cchess {
 
@@ -36,34 +50,285 @@ std::string loadFirstStsPosition() {
     return "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
 }
 
+// Opening, middlegame and endgame positions for the fixed-depth benches.
+const std::vector<std::string> BENCH_POSITIONS = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+    "rnbqkb1r/pp1p1ppp/4pn2/2p5/2PP4/2N5/PP2PPPP/R1BQKBNR w KQkq - 0 4",
+    "r2q1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP1QBPPP/R3K2R w KQ - 0 10",
+    "r1bq1rk1/ppp2ppp/2np1n2/2b1p3/2B1P3/2NP1N2/PPP2PPP/R1BQ1RK1 w - - 0 7",
+    "2rq1rk1/pb1nbppp/1p2pn2/2pp4/3P4/1P1BPN2/PBPN1PPP/2RQ1RK1 w - - 0 11",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "8/8/4kpp1/3p1b2/p6P/2B5/6P1/6K1 b - - 0 47",
+    "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1",
+    "4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 7 19",
+};
+
+// The bench positions after each legal first move, taken round-robin across
+// the positions so that a short run still starts from all of them.
+std::vector<Board> firstMoveOpenings(size_t count) {
+    std::vector<std::vector<Board>> children;
+    size_t total = 0;
+    for (const auto& fen : BENCH_POSITIONS) {
+        Board board(fen);
+        MoveList moves = board.getLegalMoves();
+        std::vector<Board> after;
+        for (size_t i = 0; i < moves.size(); ++i) {
+            Board child(board);
+            child.makeMoveUnchecked(moves[i]);
+            after.push_back(child);
+        }
+        total += after.size();
+        children.push_back(std::move(after));
+    }
+
+    std::vector<Board> openings;
+    for (size_t index = 0; openings.size() < std::min(count, total); ++index) {
+        for (const auto& after : children) {
+            if (index < after.size() && openings.size() < count)
+                openings.push_back(after[index]);
+        }
+    }
+    return openings;
+}
+
+// One player of the correction bench: its settings and search totals across games.
+struct BenchPlayer {
+    bool useCorrection = true;
+    uint64_t nodes = 0;
+    double seconds = 0.0;
+};
+
+// Plays a game from start with maxNodes per move and returns White's result
+// (1, 0.5 or 0). Each side has its own tables, kept for the whole game. Ends on
+// mate, stalemate, the 50-move rule, threefold repetition, adjudication
+// (Adjudication.h) or after MAX_GAME_PLIES.
+double playFixedNodeGame(const Board& start, uint64_t maxNodes, BenchPlayer& white,
+                         BenchPlayer& black) {
+    constexpr int MAX_GAME_PLIES = 400;
+    std::array<BenchPlayer*, 2> players = {&white, &black};
+    std::array<std::unique_ptr<TranspositionTable>, 2> tts = {
+        std::make_unique<TranspositionTable>(TranspositionTable::DEFAULT_WORKER_SIZE_MB),
+        std::make_unique<TranspositionTable>(TranspositionTable::DEFAULT_WORKER_SIZE_MB)};
+    std::array<std::unique_ptr<eval::PawnTable>, 2> pawnTables = {
+        std::make_unique<eval::PawnTable>(), std::make_unique<eval::PawnTable>()};
+    std::array<std::unique_ptr<CorrectionHistory>, 2> corrections = {
+        std::make_unique<CorrectionHistory>(), std::make_unique<CorrectionHistory>()};
+
+    Board board(start);
+    std::vector<uint64_t> hashes = {board.position().hash()};
+    Adjudicator adjudicator;
+    Adjudication verdict = Adjudication::None;
+    for (int ply = 0; ply < MAX_GAME_PLIES; ++ply) {
+        if (board.isCheckmate())
+            return board.sideToMove() == Color::White ? 0.0 : 1.0;
+        if (board.isStalemate() || board.isDraw() ||
+            isThreefoldRepetition(hashes, board.halfmoveClock()) ||
+            verdict == Adjudication::Draw)
+            return 0.5;
+        if (verdict != Adjudication::None)
+            return verdict == Adjudication::WhiteWins ? 1.0 : 0.0;
+
+        Color mover = board.sideToMove();
+        size_t us = mover == Color::White ? 0 : 1;
+        SearchConfig config;
+        config.maxDepth = MAX_SEARCH_DEPTH;
+        config.maxNodes = maxNodes;
+        config.searchTime = std::chrono::hours(24);
+        config.useCorrection = players[us]->useCorrection;
+
+        int score = 0;
+        Search search(
+            board, config, *tts[us], *pawnTables[us], *corrections[us],
+            [&score](const SearchInfo& info) { score = info.score; },
+            std::vector<uint64_t>(hashes.begin(), hashes.end() - 1));
+        int moveNumber = board.fullmoveNumber();
+        auto moveStart = std::chrono::steady_clock::now();
+        Move best = search.findBestMove();
+        players[us]->seconds +=
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - moveStart).count();
+        players[us]->nodes += search.totalNodes();
+
+        board.makeMoveUnchecked(best);
+        hashes.push_back(board.position().hash());
+        verdict = adjudicator.update(mover, moveNumber, mover == Color::White ? score : -score);
+    }
+    return 0.5;
+}
+
+// Elo difference for a score fraction in (0, 1); +0.0 rather than -0.0 at 0.5
+double eloFromScore(double score) {
+    return -400.0 * std::log10(1.0 / score - 1.0) + 0.0;
+}
+
+#ifdef CCHESS_COROUTINES
+// Prints one bench row: positions/s and nodes/s of a run on one thread.
+void printInterleaveRow(const std::string& label, size_t positions, uint64_t nodes,
+                        double seconds) {
+    double posPerSec = seconds > 0 ? static_cast<double>(positions) / seconds : 0.0;
+    double nodesPerSec = seconds > 0 ? static_cast<double>(nodes) / seconds : 0.0;
+    std::cout << std::left << std::setw(26) << label << std::right << std::fixed
+              << std::setprecision(2) << std::setw(10) << posPerSec << std::setw(14)
+              << static_cast<uint64_t>(nodesPerSec) << std::setw(10) << std::setprecision(3)
+              << seconds << "\n";
+}
+#endif  // CCHESS_COROUTINES
+
+// Raw counts plus IPC and per-node rates, omitting events that were not counted.
+nlohmann::json countersToJson(const PerfReading& reading, uint64_t nodes) {
+    nlohmann::json out = nlohmann::json::object();
+    nlohmann::json perNode = nlohmann::json::object();
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+        auto e = static_cast<PerfEvent>(i);
+        if (!reading[e])
+            continue;
+        out[PerfCounters::name(e)] = *reading[e];
+        if (nodes > 0)
+            perNode[PerfCounters::name(e)] =
+                static_cast<double>(*reading[e]) / static_cast<double>(nodes);
+    }
+    if (auto ipc = reading.ipc())
+        out["ipc"] = *ipc;
+    out["per_node"] = std::move(perNode);
+    return out;
+}
+
+// Compact one-line form for the per-iteration console output.
+std::string formatCounters(const PerfReading& reading, uint64_t nodes) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    if (auto ipc = reading.ipc())
+        oss << "ipc=" << *ipc;
+    if (nodes == 0)
+        return oss.str();
+    auto perNode = [&](const char* label, PerfEvent e) {
+        if (reading[e])
+            oss << "  " << label << "="
+                << static_cast<double>(*reading[e]) / static_cast<double>(nodes);
+    };
+    perNode("cyc/n", PerfEvent::Cycles);
+    perNode("l1d/n", PerfEvent::L1dMisses);
+    perNode("llc/n", PerfEvent::LlcMisses);
+    perNode("dtlb/n", PerfEvent::DtlbMisses);
+    perNode("br/n", PerfEvent::BranchMisses);
+    return oss.str();
+}
+
+// Raw sampled counts: depth[d], bound by name, age[slot][age], hit margins from -8 to +8.
+nlohmann::json diagnosticsToJson(const TTDiagnostics& d) {
+    auto counts = [](const auto& histogram) {
+        nlohmann::json arr = nlohmann::json::array();
+        for (uint64_t n : histogram)
+            arr.push_back(n);
+        return arr;
+    };
+
+    nlohmann::json out;
+    out["sampled_clusters"] = d.sampledClusters;
+    out["cluster_count"] = d.clusterCount;
+    out["empty_slots"] = d.emptySlots;
+    out["depth"] = counts(d.depth);
+    out["bound"] = {{"exact", d.bound[static_cast<size_t>(TTBound::EXACT)]},
+                    {"lower", d.bound[static_cast<size_t>(TTBound::LOWER)]},
+                    {"upper", d.bound[static_cast<size_t>(TTBound::UPPER)]}};
+    nlohmann::json age = nlohmann::json::array();
+    for (const auto& slot : d.age)
+        age.push_back(counts(slot));
+    out["age_by_slot"] = std::move(age);
+    out["hit_depth_margin"] = counts(d.hitDepthMargin);
+    return out;
+}
+
 }  // namespace
 
-void ProfileBench::run(int searchTimeMs) {
+void ProfileBench::run(int searchTimeMs, const std::string& jsonPath, const std::string& tracePath,
+                       const std::string& affinity) {
     std::string fen = loadFirstStsPosition();
 
+    // Pin before allocating the tables so first touch puts them on this CPU's node
+    int pinnedCpu = -1;
+    try {
+        ThreadPlacement placement = ThreadPlacement::parse(affinity);
+        pinnedCpu = placement.pinCurrentThread(0);
+        if (placement.enabled() && pinnedCpu < 0)
+            std::cerr << "bench: cannot pin to CPU " << placement.cpuFor(0) << "\n";
+    } catch (const ChessError& e) {
+        std::cerr << "bench: " << e.what() << "\n";
+    }
+    const CpuTopology& topology = CpuTopology::get();
+    int startCpu = currentCpu();
+
     std::cout << "=== Profile Bench ===\n";
     std::cout << "FEN:  " << fen << "\n";
-    std::cout << "Time: " << searchTimeMs << " ms\n\n";
+    std::cout << "Time: " << searchTimeMs << " ms\n";
+    std::cout << "CPU:  " << (pinnedCpu >= 0 ? "pinned to " : "unpinned, started on ") << startCpu
+              << " (node " << topology.nodeOf(startCpu) << " of " << topology.nodes.size()
+              << ")\n";
+    std::cout << "ISA:  " << describeIsa() << "\n";
+    std::cout << "Mem:  " << describeMemoryProfile() << "\n";
+
+    PerfCounters counters;
+    if (counters.available())
+        std::cout << "Hardware counters: on\n\n";
+    else
+        std::cout << "Hardware counters: off (" << counters.reason() << ")\n\n";
 
     Board board(fen);
     TranspositionTable tt;
     auto pawnTable = std::make_unique<eval::PawnTable>();
+    auto correction = std::make_unique<CorrectionHistory>();
 
     SearchConfig config;
     config.searchTime = std::chrono::milliseconds(searchTimeMs);
 
+    std::unique_ptr<SearchTrace> trace;
+    if (!tracePath.empty()) {
+        trace = std::make_unique<SearchTrace>();
+        config.trace = trace.get();
+        std::cout << "Tracing to " << tracePath << " (NPS is not representative)\n\n";
+    }
+
+    // Counters per iteration are the delta since the previous iteration's report
+    nlohmann::json iterations = nlohmann::json::array();
+    PerfReading lastReading;
+    uint64_t lastNodes = 0;
+
     auto wallStart = std::chrono::steady_clock::now();
+    counters.start();
+
+    Search search(board, config, tt, *pawnTable, *correction, [&](const SearchInfo& info) {
+        PerfReading reading = counters.read();
+        PerfReading delta = reading.since(lastReading);
+        uint64_t iterationNodes = info.nodes - lastNodes;
+        lastReading = reading;
+        lastNodes = info.nodes;
 
-    Search search(board, config, tt, *pawnTable, [](const SearchInfo& info) {
+        uint64_t nps =
+            info.timeMs > 0 ? info.nodes * 1000 / static_cast<uint64_t>(info.timeMs) : 0;
         std::cout << "  depth=" << info.depth << "  score=" << info.score
                   << "  nodes=" << info.nodes << "  time=" << info.timeMs << "ms"
-                  << "  nps="
-                  << (info.timeMs > 0 ? info.nodes * 1000 / static_cast<uint64_t>(info.timeMs) : 0)
-                  << "\n";
+                  << "  nps=" << nps;
+        if (counters.available())
+            std::cout << "  " << formatCounters(delta, iterationNodes);
+        std::cout << "\n";
+
+        nlohmann::json it;
+        it["depth"] = info.depth;
+        it["score"] = info.score;
+        it["nodes"] = info.nodes;
+        it["time_ms"] = info.timeMs;
+        it["nps"] = nps;
+        if (counters.available())
+            it["counters"] = countersToJson(delta, iterationNodes);
+        iterations.push_back(std::move(it));
     });
 
     Move best = search.findBestMove();
 
+    counters.stop();
+    PerfReading total = counters.read();
     auto wallEnd = std::chrono::steady_clock::now();
     int elapsedMs =
         static_cast<int>(std::chrono::duration<double, std::milli>(wallEnd - wallStart).count());
@@ -81,6 +346,279 @@ void ProfileBench::run(int searchTimeMs) {
     std::cout << "TT hit rate: " << tts.hitRate() << "%\n";
     std::cout << "TT cutoffs:  " << tts.cutoffRate() << "%\n";
     std::cout << "TT occupancy:" << tt.occupancy() << "%\n";
+    size_t peakRss = peakRssBytes();
+    std::cout << "Peak RSS:    " << peakRss / (1024 * 1024) << " MB\n";
+    int endCpu = currentCpu();
+    std::cout << "CPU at end:  " << endCpu << " (node " << topology.nodeOf(endCpu) << ")\n";
+
+    TTDiagnostics ttDiag = tt.sample();
+    std::cout << "\n";
+    ttDiag.print(std::cout);
+
+    if (counters.available()) {
+        std::cout << "\n--- Hardware counters (per node) ---\n";
+        for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+            auto e = static_cast<PerfEvent>(i);
+            std::cout << std::left << std::setw(15) << PerfCounters::name(e) << std::right;
+            if (total[e] && totalNodes > 0)
+                std::cout << std::fixed << std::setprecision(2)
+                          << static_cast<double>(*total[e]) / static_cast<double>(totalNodes)
+                          << "\n";
+            else
+                std::cout << "n/a\n";
+        }
+        if (auto ipc = total.ipc())
+            std::cout << std::left << std::setw(15) << "ipc" << std::right << std::fixed
+                      << std::setprecision(2) << *ipc << "\n";
+    }
+
+    if (trace) {
+        if (trace->writeTo(tracePath))
+            std::cout << "\nTrace written to " << tracePath << " (" << trace->recorded()
+                      << " nodes, last " << std::min<uint64_t>(trace->recorded(), trace->capacity())
+                      << " kept)\n";
+        else
+            std::cerr << "bench: cannot write " << tracePath << "\n";
+    }
+
+    if (jsonPath.empty())
+        return;
+
+    nlohmann::json out;
+    out["fen"] = fen;
+    out["search_time_ms"] = searchTimeMs;
+    out["best_move"] = best.toAlgebraic();
+    out["nodes"] = totalNodes;
+    out["time_ms"] = elapsedMs;
+    out["nps"] = nps;
+    out["affinity"] = {{"pinned", pinnedCpu >= 0},
+                       {"start_cpu", startCpu},
+                       {"end_cpu", endCpu},
+                       {"node", topology.nodeOf(startCpu)},
+                       {"nodes", topology.nodes.size()}};
+    out["isa"] = {{"level", isaLevelName(activeIsaLevel())},
+                  {"dispatch", isaDispatchEnabled()},
+                  {"cpu_level", isaLevelName(CpuFeatures::get().level)}};
+    out["memory"] = {{"profile", lowMemoryBuild() ? "low-memory" : "default"},
+                     {"tt_mb", tt.clusterCount() * sizeof(TTCluster) / (1024 * 1024)},
+                     {"peak_rss_bytes", peakRss}};
+    out["tt"] = {{"probes", tts.probes},
+                 {"hit_rate", tts.hitRate()},
+                 {"cutoff_rate", tts.cutoffRate()},
+                 {"occupancy", tt.occupancy()},
+                 {"diagnostics", diagnosticsToJson(ttDiag)}};
+    out["counters_available"] = counters.available();
+    if (counters.available())
+        out["counters"] = countersToJson(total, totalNodes);
+    else
+        out["counters_reason"] = counters.reason();
+    out["iterations"] = std::move(iterations);
+
+    std::ofstream file(jsonPath);
+    if (!file.is_open()) {
+        std::cerr << "bench: cannot write " << jsonPath << "\n";
+        return;
+    }
+    file << out.dump(2) << "\n";
+    std::cout << "\nJSON written to " << jsonPath << "\n";
+}
+
+int ProfileBench::runInterleaved(int depth, size_t width, size_t hashMB) {
+#ifndef CCHESS_COROUTINES
+    (void)depth;
+    (void)width;
+    (void)hashMB;
+    std::cerr << "bench-interleave: rebuild with -DENABLE_COROUTINES=ON (C++20)\n";
+    return 1;
+#else
+    const std::vector<std::string>& fens = BENCH_POSITIONS;
+    using Clock = std::chrono::steady_clock;
+    auto secondsSince = [](Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    std::cout << "=== Interleaved Search Bench ===\n";
+    std::cout << "Positions: " << fens.size() << "  depth: " << depth << "  hash: " << hashMB
+              << " MB per search  (single thread, figures are per core)\n\n";
+    std::cout << std::left << std::setw(26) << "mode" << std::right << std::setw(10) << "pos/s"
+              << std::setw(14) << "nodes/s" << std::setw(10) << "sec" << "\n";
+
+    // Baseline: the regular search, one position after another
+    uint64_t baseNodes = 0;
+    auto start = Clock::now();
+    {
+        TranspositionTable tt(hashMB);
+        auto pawnTable = std::make_unique<eval::PawnTable>();
+        auto correction = std::make_unique<CorrectionHistory>();
+        SearchConfig config;
+        config.maxDepth = depth;
+        config.searchTime = std::chrono::hours(24);
+        for (const auto& fen : fens) {
+            Board board(fen);
+            Search search(board, config, tt, *pawnTable, *correction);
+            search.findBestMove();
+            baseNodes += search.totalNodes();
+        }
+    }
+    double baseSeconds = secondsSince(start);
+    printInterleaveRow("Search (1 per thread)", fens.size(), baseNodes, baseSeconds);
+
+    double lastSeconds = baseSeconds;
+    std::vector<size_t> widths = {1};
+    if (width > 1)
+        widths.push_back(width);
+    for (size_t w : widths) {
+        start = Clock::now();
+        auto results = InterleavedSearch::run(fens, depth, w, hashMB);
+        lastSeconds = secondsSince(start);
+        uint64_t nodes = 0;
+        for (const auto& r : results)
+            nodes += r.nodes;
+        printInterleaveRow("coroutines, width " + std::to_string(w), fens.size(), nodes,
+                           lastSeconds);
+    }
+
+    if (lastSeconds > 0) {
+        std::cout << "\nWidth " << widths.back() << " vs Search: " << std::setprecision(2)
+                  << baseSeconds / lastSeconds << "x positions/s per core\n";
+    }
+    return 0;
+#endif
+}
+
+int ProfileBench::runHotTable(int depth, size_t hotKB, const std::vector<size_t>& hashSizesMB) {
+    const std::vector<std::string>& fens = BENCH_POSITIONS;
+    if (hotKB == 0)
+        hotKB = TranspositionTable::defaultHotTableKB();
+
+    std::cout << "=== Hot TT Bench ===\n";
+    std::cout << "Positions: " << fens.size() << "  depth: " << depth << "  hot table: " << hotKB
+              << " KB (L2 " << l2CacheBytes() / 1024 << " KB)  (single thread)\n\n";
+    std::cout << std::left << std::setw(16) << "table" << std::right << std::setw(12) << "nodes"
+              << std::setw(12) << "nodes/s" << std::setw(9) << "sec" << std::setw(8) << "hit%"
+              << std::setw(8) << "cut%" << std::setw(10) << "hot-pr%" << std::setw(9) << "hot-hit%"
+              << "\n";
+
+    for (size_t hashMB : hashSizesMB) {
+        uint64_t baseNodes = 0;
+        double baseSeconds = 0.0;
+        for (bool hot : {false, true}) {
+            // One table per configuration, kept across positions as in a game
+            TranspositionTable tt(hashMB);
+            if (hot)
+                tt.setHotTable(hotKB);
+            auto pawnTable = std::make_unique<eval::PawnTable>();
+            auto correction = std::make_unique<CorrectionHistory>();
+            SearchConfig config;
+            config.maxDepth = depth;
+            config.searchTime = std::chrono::hours(24);
+
+            uint64_t nodes = 0;
+            TTStats stats;
+            auto start = std::chrono::steady_clock::now();
+            for (const auto& fen : fens) {
+                Board board(fen);
+                Search search(board, config, tt, *pawnTable, *correction);
+                search.findBestMove();
+                nodes += search.totalNodes();
+                const TTStats& s = tt.stats();
+                stats.probes += s.probes;
+                stats.hits += s.hits;
+                stats.cutoffs += s.cutoffs;
+                stats.hotProbes += s.hotProbes;
+                stats.hotHits += s.hotHits;
+                tt.stats().reset();
+            }
+            double seconds =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            std::string label = std::to_string(hashMB) + " MB" + (hot ? " + hot" : "");
+            double hotShare = stats.probes ? 100.0 * static_cast<double>(stats.hotProbes) /
+                                                 static_cast<double>(stats.probes)
+                                           : 0.0;
+            std::cout << std::left << std::setw(16) << label << std::right << std::setw(12)
+                      << nodes << std::setw(12)
+                      << static_cast<uint64_t>(seconds > 0 ? static_cast<double>(nodes) / seconds
+                                                           : 0.0)
+                      << std::fixed << std::setprecision(2) << std::setw(9) << seconds
+                      << std::setprecision(1) << std::setw(8) << stats.hitRate() << std::setw(8)
+                      << stats.cutoffRate() << std::setw(10) << hotShare << std::setw(9)
+                      << stats.hotHitRate() << "\n";
+            if (!hot) {
+                baseNodes = nodes;
+                baseSeconds = seconds;
+            } else if (baseSeconds > 0 && seconds > 0 && baseNodes > 0) {
+                std::cout << std::left << std::setw(16) << "  hot vs single" << std::right
+                          << std::setprecision(3) << std::setw(12)
+                          << static_cast<double>(nodes) / static_cast<double>(baseNodes) << "x"
+                          << std::setw(11)
+                          << (static_cast<double>(nodes) / seconds) /
+                                 (static_cast<double>(baseNodes) / baseSeconds)
+                          << "x" << std::setw(8) << baseSeconds / seconds << "x\n";
+            }
+        }
+    }
+    return 0;
+}
+
+int ProfileBench::runCorrection(int games, uint64_t nodes) {
+    size_t pairs = static_cast<size_t>(std::max(games, 2)) / 2;
+    std::vector<Board> openings = firstMoveOpenings(pairs);
+
+    std::cout << "=== Correction History Bench ===\n";
+    std::cout << "Games: " << openings.size() * 2 << "  nodes/move: " << nodes
+              << "  (single thread, each opening played with both colours)\n\n";
+
+    BenchPlayer corrected;
+    BenchPlayer plain;
+    plain.useCorrection = false;
+    int wins = 0;
+    int draws = 0;
+    int losses = 0;
+    for (size_t i = 0; i < openings.size(); ++i) {
+        for (bool correctedWhite : {true, false}) {
+            double whiteResult =
+                correctedWhite ? playFixedNodeGame(openings[i], nodes, corrected, plain)
+                               : playFixedNodeGame(openings[i], nodes, plain, corrected);
+            double result = correctedWhite ? whiteResult : 1.0 - whiteResult;
+            if (result == 1.0)
+                ++wins;
+            else if (result == 0.0)
+                ++losses;
+            else
+                ++draws;
+            std::cout << "game " << std::setw(4) << 2 * i + (correctedWhite ? 1 : 2)
+                      << "  corrected " << (correctedWhite ? "white" : "black") << "  "
+                      << (result == 1.0 ? "win " : result == 0.0 ? "loss" : "draw") << "  (+"
+                      << wins << " =" << draws << " -" << losses << ")\n";
+        }
+    }
+
+    // Elo with a 95% interval from the per-game score variance
+    double n = static_cast<double>(wins + draws + losses);
+    double score = (wins + 0.5 * draws) / n;
+    double variance = (wins * (1.0 - score) * (1.0 - score) +
+                       draws * (0.5 - score) * (0.5 - score) + losses * score * score) /
+                      n;
+    double margin = 1.96 * std::sqrt(variance / n);
+    std::cout << "\ncorrected vs plain: +" << wins << " =" << draws << " -" << losses << "  score "
+              << std::fixed << std::setprecision(1) << 100.0 * score << "%";
+    if (score > 0.0 && score < 1.0) {
+        double low = eloFromScore(std::max(score - margin, 1e-6));
+        double high = eloFromScore(std::min(score + margin, 1.0 - 1e-6));
+        std::cout << "  Elo " << std::showpos << eloFromScore(score) << std::noshowpos
+                  << " +/- " << (high - low) / 2 << " (95%)";
+    }
+    std::cout << "\n";
+    for (const BenchPlayer* player : {&corrected, &plain}) {
+        std::cout << (player == &corrected ? "corrected" : "plain    ") << "  nodes/s "
+                  << static_cast<uint64_t>(player->seconds > 0
+                                               ? static_cast<double>(player->nodes) /
+                                                     player->seconds
+                                               : 0.0)
+                  << "\n";
+    }
+    return 0;
 }
 
 }  // namespace cchess
@@ -1,19 +1,62 @@
 #ifndef CCHESS_PROFILEBENCH_H
 #define CCHESS_PROFILEBENCH_H
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
 namespace cchess {
 
 // Non-interactive benchmark mode for profiling.
-// Usage: cchess --bench [time_ms]
-//   time_ms  Search time per position in milliseconds (default: 30000)
+// Usage: cchess --bench [time_ms] [--json <file>] [--trace <file>] [--affinity <cpu>|auto]
+//   time_ms     Search time per position in milliseconds (default: 30000)
+//   --json      Also write the results, including per-iteration data, as JSON
+//   --trace     Record the search tree (see SearchTrace.h) and write it to file;
+//               inspect it with cchess --trace-summary <file>
+//   --affinity  Pin the search to a CPU before the tables are allocated; compare
+//               NPS against an unpinned run to measure migration and remote memory
 //
 // Runs the first position from STS1.epd (or Kiwipete as fallback) for the
 // specified duration and prints NPS/depth stats. Designed to be driven
 // directly from the command line without interactive prompts so it works
 // cleanly with LD_PRELOAD profilers.
+//
+// On Linux, hardware counters (cycles, IPC, L1d/LLC/dTLB misses, branch
+// misses) are reported per node for every iteration and for the whole run
+// when perf_event_open is permitted; otherwise they are left out.
 class ProfileBench {
 public:
-    static void run(int searchTimeMs = 30000);
+    static void run(int searchTimeMs = 30000, const std::string& jsonPath = "",
+                    const std::string& tracePath = "", const std::string& affinity = "");
+
+    // Usage: cchess --bench-interleave [depth] [width] [hash_mb]
+    //
+    // Searches a fixed set of positions to a fixed depth on one thread, first
+    // with Search (one search per thread), then with InterleavedSearch at
+    // width 1 and at the given width, and reports positions/s per core for each.
+    // Requires a build with -DENABLE_COROUTINES=ON; returns an exit code.
+    static int runInterleaved(int depth = 7, size_t width = 8, size_t hashMB = 16);
+
+    // Usage: cchess --bench-hot-tt [depth] [hot_kb] [hash_mb ...]
+    //
+    // Searches the same positions to a fixed depth with a single-level table and
+    // with a hot table added (see TranspositionTable), at each main-table size,
+    // and reports nodes, NPS, overall hit and cutoff rates, the share of probes
+    // served by the hot table and its hit rate. hot_kb 0 picks the default size
+    // for this CPU's L2.
+    static int runHotTable(int depth = 10, size_t hotKB = 0,
+                           const std::vector<size_t>& hashSizesMB = {1, 16, 256});
+
+    // Usage: cchess --bench-correction [games] [nodes]
+    //
+    // Plays fixed-node self-play games between the engine with correction
+    // history and the engine without it (SearchConfig::useCorrection), each
+    // side with its own tables for the game (a DEFAULT_WORKER_SIZE_MB TT).
+    // Openings are the bench positions after each legal first move, each played
+    // with both colours. Reports W/D/L for the corrected side, the Elo
+    // difference with a 95% margin, and each side's nodes/s.
+    static int runCorrection(int games = 64, uint64_t nodes = 20000);
 };
 
 }  // namespace cchess
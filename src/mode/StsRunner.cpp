@@ -213,7 +213,8 @@ void StsRunner::run() {
             Board board(fen);
             TranspositionTable tt;
             auto pawnTable = std::make_unique<eval::PawnTable>();
-            Search search(board, config, tt, *pawnTable);
+            auto correction = std::make_unique<CorrectionHistory>();
+            Search search(board, config, tt, *pawnTable, *correction);
             Move bestMove = search.findBestMove();
 
             if (bestMove.isNull()) {
@@ -0,0 +1,79 @@
+#include "mode/Telemetry.h"
+
+#include "utils/Error.h"
+
+#include <chrono>
+#include <utility>
+
+namespace cchess {
+
+TelemetryWriter::TelemetryWriter(const std::string& path) : file_(path, std::ios::app) {
+    if (!file_.is_open())
+        throw ChessError("Cannot open telemetry file: " + path);
+    writer_ = std::thread(&TelemetryWriter::writerLoop, this);
+}
+
+TelemetryWriter::~TelemetryWriter() {
+    if (!enabled())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    writer_.join();
+}
+
+void TelemetryWriter::write(nlohmann::json record) {
+    if (!enabled())
+        return;
+    record["ts_ms"] = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(record));
+        ++queued_;
+    }
+    wake_.notify_one();
+}
+
+void TelemetryWriter::flush() {
+    if (!enabled())
+        return;
+    std::unique_lock<std::mutex> lock(mutex_);
+    uint64_t target = queued_;
+    drained_.wait(lock, [&]() { return written_ >= target; });
+}
+
+uint64_t TelemetryWriter::written() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return written_;
+}
+
+void TelemetryWriter::writerLoop() {
+    std::vector<nlohmann::json> batch;
+    std::string text;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [&]() { return stopping_ || !queue_.empty(); });
+        if (queue_.empty())
+            break;  // stopping, and nothing left to write
+        batch.swap(queue_);
+        lock.unlock();
+
+        // Serialised and written outside the lock so write() never waits on the disk
+        text.clear();
+        for (const auto& record : batch)
+            text += record.dump() + "\n";
+        file_ << text;
+        file_.flush();
+
+        lock.lock();
+        written_ += batch.size();
+        batch.clear();
+        drained_.notify_all();
+    }
+}
+
+}  // namespace cchess
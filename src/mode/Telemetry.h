@@ -0,0 +1,60 @@
+#ifndef CCHESS_TELEMETRY_H
+#define CCHESS_TELEMETRY_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cchess {
+
+// Appends JSON records, one per line (JSONL), to a telemetry file for
+// dashboards to ingest.
+//
+// write() only stamps the record and queues it; a background thread serialises
+// and writes the queue in batches, so a caller timing a move never waits on the
+// disk. A default-constructed writer is disabled and ignores every record.
+class TelemetryWriter {
+public:
+    TelemetryWriter() = default;
+
+    // Appends to path (created if missing). Throws ChessError if it cannot be opened.
+    explicit TelemetryWriter(const std::string& path);
+
+    // Writes everything still queued.
+    ~TelemetryWriter();
+
+    TelemetryWriter(const TelemetryWriter&) = delete;
+    TelemetryWriter& operator=(const TelemetryWriter&) = delete;
+
+    bool enabled() const { return writer_.joinable(); }
+
+    // Adds "ts_ms" (Unix time in milliseconds) and queues the record.
+    void write(nlohmann::json record);
+
+    // Blocks until every record queued so far is on disk.
+    void flush();
+
+    uint64_t written() const;
+
+private:
+    void writerLoop();
+
+    std::ofstream file_;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;     // records queued, or stopping
+    std::condition_variable drained_;  // a batch was written
+    std::vector<nlohmann::json> queue_;
+    uint64_t queued_ = 0;
+    uint64_t written_ = 0;
+    bool stopping_ = false;
+    std::thread writer_;
+};
+
+}  // namespace cchess
+
+#endif  // CCHESS_TELEMETRY_H
@@ -1,10 +1,16 @@
 #include "uci/Uci.h"
 
 #include "ai/Eval.h"
+#include "ai/MateSolver.h"
 #include "ai/Search.h"
 #include "ai/SearchConfig.h"
+#include "ai/SearchTrace.h"
+#include "ai/TTDiagnostics.h"
 #include "book/PolyglotBook.h"
 #include "core/Move.h"
+#include "utils/Affinity.h"
+#include "utils/CpuFeatures.h"
+#include "utils/Error.h"
 
 #include <algorithm>
 #include <chrono>
@@ -14,6 +20,16 @@
 
 namespace cchess {
 
+namespace {
+
+constexpr size_t kMaxHashMB = 65536;
+constexpr size_t kMaxHotHashKB = 16384;
+
+// How often a long iteration reports progress (see SearchConfig::progressInterval)
+constexpr std::chrono::milliseconds kProgressInterval{1000};
+
+}  // namespace
+
 void Uci::loop() {
     // Disable stdout buffering for UCI protocol
     std::cout.setf(std::ios::unitbuf);
@@ -40,46 +56,62 @@ void Uci::loop() {
             handleSetOption(iss);
         else if (cmd == "eval")
             handleEval();
+        else if (cmd == "ttstats")
+            handleTTStats();
         else if (cmd == "quit") {
             handleStop();
             return;
         }
     }
 
-    // EOF reached — wait for search to finish naturally (don't force stop)
+    // EOF reached — wait for search to finish naturally (don't force stop), except
+    // an infinite search, which would wait for a stop that can no longer come
+    if (infiniteSearch_)
+        stopFlag_.store(true);
     joinSearch();
 }
 
 void Uci::handleUci() {
-    std::cout << "id name CChess\n";
+    std::cout << "id name CChess (" << isaLevelName(activeIsaLevel()) << ")\n";
     std::cout << "id author Adam\n";
+    std::cout << "option name Hash type spin default " << TranspositionTable::DEFAULT_SIZE_MB
+              << " min 1 max " << kMaxHashMB << "\n";
+    std::cout << "option name HotHashKB type spin default 0 min 0 max " << kMaxHotHashKB << "\n";
     std::cout << "option name OwnBook type check default false\n";
     std::cout << "option name BookFile type string default engines/book.bin\n";
+    std::cout << "option name TraceFile type string default <empty>\n";
+    std::cout << "option name CpuAffinity type string default <empty>\n";
     std::cout << "uciok\n";
 }
 
 void Uci::handleIsReady() {
-    joinSearch();
+    // An infinite search only ends on stop, so isready is answered while it runs
+    if (!infiniteSearch_)
+        joinSearch();
     std::cout << "readyok\n";
 }
 
 void Uci::handleNewGame() {
     joinSearch();
     tt_.clear();
+    correction_->clear();
     board_ = Board();
     gameHistory_.clear();
 }
 
 void Uci::handlePosition(std::istringstream& args) {
     joinSearch();
+    parsePosition(args, board_, gameHistory_);
+}
 
+void Uci::parsePosition(std::istringstream& args, Board& board, std::vector<uint64_t>& history) {
     std::string token;
     args >> token;
 
-    gameHistory_.clear();
+    history.clear();
 
     if (token == "startpos") {
-        board_ = Board();
+        board = Board();
         args >> token;  // consume "moves" if present
     } else if (token == "fen") {
         std::string fen;
@@ -89,7 +121,7 @@ void Uci::handlePosition(std::istringstream& args) {
                 fen += ' ';
             fen += token;
         }
-        board_ = Board(fen);
+        board = Board(fen);
         args >> token;  // consume "moves" if present
     }
 
@@ -103,10 +135,10 @@ void Uci::handlePosition(std::istringstream& args) {
             continue;
 
         PieceType promo = parsed->isPromotion() ? parsed->promotion() : PieceType::None;
-        auto legal = board_.findLegalMove(parsed->from(), parsed->to(), promo);
+        auto legal = board.findLegalMove(parsed->from(), parsed->to(), promo);
         if (legal) {
-            gameHistory_.push_back(board_.position().hash());
-            board_.makeMoveUnchecked(*legal);
+            history.push_back(board.position().hash());
+            board.makeMoveUnchecked(*legal);
         }
     }
 }
@@ -135,7 +167,7 @@ void Uci::handleGo(std::istringstream& args) {
 
     std::string token;
     int wtime = -1, btime = -1, winc = 0, binc = 0;
-    int depth = -1, movetime = -1;
+    int depth = -1, movetime = -1, mate = 0;
     bool infinite = false;
 
     while (args >> token) {
@@ -153,11 +185,15 @@ void Uci::handleGo(std::istringstream& args) {
             args >> movetime;
         else if (token == "infinite")
             infinite = true;
+        else if (token == "mate")
+            args >> mate;
     }
 
     SearchConfig config;
     config.stopSignal = &stopFlag_;
+    config.progressInterval = kProgressInterval;
     stopFlag_.store(false);
+    infiniteSearch_ = false;
 
     if (depth > 0) {
         config.maxDepth = depth;
@@ -165,8 +201,9 @@ void Uci::handleGo(std::istringstream& args) {
     } else if (movetime > 0) {
         config.searchTime = std::chrono::milliseconds(movetime);
     } else if (infinite) {
-        config.maxDepth = 64;
-        config.searchTime = std::chrono::milliseconds(300000);
+        config.infinite = true;
+        config.maxDepth = MAX_SEARCH_DEPTH;
+        infiniteSearch_ = true;
     } else {
         // Time management: allocate from remaining time
         int remaining = (board_.sideToMove() == Color::White) ? wtime : btime;
@@ -184,47 +221,124 @@ void Uci::handleGo(std::istringstream& args) {
 
     // Info callback for UCI info lines
     auto infoCallback = [](const SearchInfo& info) {
-        std::cout << "info depth " << info.depth;
+        std::cout << "info " << formatInfo(info) << "\n";
+    };
+
+    if (mate > 0) {
+        // One budget for both phases: the solver gets three quarters of it and the
+        // fallback search, if there is no proof, whatever is left
+        auto budget = std::chrono::milliseconds(movetime > 0 ? movetime : 300000);
+        auto deadline = std::chrono::steady_clock::now() + budget;
+        MateSolverConfig mateConfig;
+        mateConfig.maxMoves = mate;
+        mateConfig.stopSignal = &stopFlag_;
+        mateConfig.timeLimit = budget - budget / 4;
+        searchThread_ = std::thread([this, mateConfig, config, deadline, infoCallback,
+                                     boardCopy = board_, historyCopy = gameHistory_,
+                                     placement = placement_]() mutable {
+            placeSearchThread(placement);
+            if (!mateSolver_)
+                mateSolver_ = std::make_unique<MateSolver>();
+            MateResult result = mateSolver_->solve(boardCopy, mateConfig);
+            if (result.found) {
+                SearchInfo info;
+                info.depth = 2 * result.mateIn - 1;
+                info.score = eval::SCORE_MATE - info.depth;
+                info.nodes = result.nodes;
+                info.timeMs = result.timeMs;
+                for (size_t i = 0; i < result.pv.size() && i < MAX_PLY; ++i)
+                    info.pv.push_back(result.pv[i]);
+                std::cout << "info " << formatInfo(info) << "\n";
+                std::cout << "info string proof size " << result.proofSize << "\n";
+                std::cout << "bestmove " << result.bestMove.toAlgebraic() << "\n";
+                return;
+            }
+
+            // No proof: answer with a normal search so the GUI still gets a move
+            std::cout << "info string no mate in " << mateConfig.maxMoves
+                      << (result.disproven ? "" : " found in time") << " (" << result.nodes
+                      << " nodes)\n";
+            if (stopFlag_.load()) {
+                // Stopped while solving: the stop would abort the search before its
+                // first iteration, so a one-ply search that ignores it picks the move
+                config.stopSignal = nullptr;
+                config.maxDepth = 1;
+            } else {
+                config.searchTime = std::max(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                        deadline - std::chrono::steady_clock::now()),
+                    std::chrono::milliseconds(1));
+            }
+            Search search(boardCopy, config, tt_, *pawnTable_, *correction_, infoCallback,
+                          std::move(historyCopy));
+            Move best = search.findBestMove();
+            std::cout << "bestmove " << best.toAlgebraic() << "\n";
+        });
+        return;
+    }
 
-        // Score: mate or centipawns
+    // Launch search in background thread
+    Board boardCopy = board_;
+    std::vector<uint64_t> historyCopy = gameHistory_;
+    searchThread_ = std::thread([this, config, infoCallback, boardCopy, infinite,
+                                 traceFile = traceFile_,
+                                 historyCopy = std::move(historyCopy),
+                                 placement = placement_]() mutable {
+        placeSearchThread(placement);
+        std::unique_ptr<SearchTrace> trace;
+        if (!traceFile.empty()) {
+            trace = std::make_unique<SearchTrace>();
+            config.trace = trace.get();
+        }
+        Search search(boardCopy, config, tt_, *pawnTable_, *correction_, infoCallback, std::move(historyCopy));
+        Move best = search.findBestMove();
+        // The search can finish early (a forced mate, MAX_SEARCH_DEPTH); go infinite
+        // still only answers once stopped
+        while (infinite && !stopFlag_.load())
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        std::cout << "bestmove " << best.toAlgebraic() << "\n";
+
+        // Written after bestmove so tracing never costs the GUI clock time
+        if (trace && !trace->writeTo(traceFile))
+            std::cerr << "info string Warning: could not write trace file: " << traceFile << "\n";
+    });
+}
+
+std::string Uci::formatInfo(const SearchInfo& info) {
+    std::ostringstream out;
+    out << "depth " << info.depth;
+
+    // Score: mate or centipawns. A progress report of an unfinished iteration has none.
+    if (!info.partial) {
         if (info.score >= eval::SCORE_MATE - 200) {
             int matePly = eval::SCORE_MATE - info.score;
             int mateN = (matePly + 1) / 2;
-            std::cout << " score mate " << mateN;
+            out << " score mate " << mateN;
         } else if (info.score <= -(eval::SCORE_MATE - 200)) {
             int matePly = eval::SCORE_MATE + info.score;
             int mateN = (matePly + 1) / 2;
-            std::cout << " score mate -" << mateN;
+            out << " score mate -" << mateN;
         } else {
-            std::cout << " score cp " << info.score;
+            out << " score cp " << info.score;
         }
+    }
 
-        std::cout << " nodes " << info.nodes;
+    out << " nodes " << info.nodes;
 
-        int timeMs = std::max(info.timeMs, 1);
-        uint64_t nps = info.nodes * 1000 / static_cast<uint64_t>(timeMs);
-        std::cout << " nps " << nps;
-        std::cout << " time " << info.timeMs;
+    int timeMs = std::max(info.timeMs, 1);
+    uint64_t nps = info.nodes * 1000 / static_cast<uint64_t>(timeMs);
+    out << " nps " << nps;
+    out << " time " << info.timeMs;
+    if (info.hashfull >= 0)
+        out << " hashfull " << info.hashfull;
 
-        if (!info.pv.empty()) {
-            std::cout << " pv";
-            for (const auto& m : info.pv) {
-                std::cout << " " << m.toAlgebraic();
-            }
+    if (!info.pv.empty()) {
+        out << " pv";
+        for (const auto& m : info.pv) {
+            out << " " << m.toAlgebraic();
         }
-
-        std::cout << "\n";
-    };
-
-    // Launch search in background thread
-    Board boardCopy = board_;
-    std::vector<uint64_t> historyCopy = gameHistory_;
-    searchThread_ = std::thread([this, config, infoCallback, boardCopy,
-                                 historyCopy = std::move(historyCopy)]() mutable {
-        Search search(boardCopy, config, tt_, *pawnTable_, infoCallback, std::move(historyCopy));
-        Move best = search.findBestMove();
-        std::cout << "bestmove " << best.toAlgebraic() << "\n";
-    });
+    }
+    return out.str();
 }
 
 void Uci::handleSetOption(std::istringstream& args) {
@@ -251,7 +365,35 @@ void Uci::handleSetOption(std::istringstream& args) {
         }
     }
 
-    if (name == "OwnBook") {
+    if (name == "Hash") {
+        size_t mb = 0;
+        try {
+            mb = std::stoul(value);
+        } catch (const std::exception&) {
+        }
+        if (mb < 1 || mb > kMaxHashMB) {
+            std::cerr << "info string Warning: invalid Hash value: " << value << "\n";
+            return;
+        }
+        joinSearch();
+        tt_.resize(mb);
+        tablesNode_ = -1;  // the new table has not been placed yet
+    } else if (name == "HotHashKB") {
+        // Non-standard: L2-sized table for depth <= 1 and quiescence entries; 0 = off
+        size_t kb = 0;
+        try {
+            kb = std::stoul(value);
+        } catch (const std::exception&) {
+            kb = kMaxHotHashKB + 1;
+        }
+        if (kb > kMaxHotHashKB) {
+            std::cerr << "info string Warning: invalid HotHashKB value: " << value << "\n";
+            return;
+        }
+        joinSearch();
+        tt_.setHotTable(kb);
+        tablesNode_ = -1;
+    } else if (name == "OwnBook") {
         useOwnBook_ = (value == "true");
     } else if (name == "BookFile") {
         if (value.empty()) {
@@ -259,9 +401,39 @@ void Uci::handleSetOption(std::istringstream& args) {
         } else if (!book_.load(value)) {
             std::cerr << "info string Warning: could not load book file: " << value << "\n";
         }
+    } else if (name == "TraceFile") {
+        traceFile_ = (value == "<empty>") ? "" : value;
+    } else if (name == "CpuAffinity") {
+        try {
+            placement_ = ThreadPlacement::parse(value);
+        } catch (const ChessError& e) {
+            std::cerr << "info string Warning: " << e.what() << "\n";
+        }
     }
 }
 
+// Runs on the search thread: pins it when CpuAffinity is set and moves the hash
+// tables to its NUMA node, once per node change.
+void Uci::placeSearchThread(const ThreadPlacement& placement) {
+    int cpu = placement.pinCurrentThread(0);
+    if (cpu < 0)
+        return;
+    int node = CpuTopology::get().nodeOf(cpu);
+    if (node < 0 || node == tablesNode_)
+        return;
+    tt_.bindToNode(node);
+    bindMemoryToNode(pawnTable_.get(), sizeof(eval::PawnTable), node);
+    tablesNode_ = node;
+}
+
+// Non-standard: sampled TT content histograms. Safe mid-search, where the sample is
+// approximate because the search keeps writing.
+void Uci::handleTTStats() {
+    // Sampling reads the entries a running search writes, so wait for it as Hash does
+    joinSearch();
+    tt_.sample().print(std::cout);
+}
+
 void Uci::handleEval() {
     const Position& pos = board_.position();
     Bitboard wp = pos.pieces(PieceType::Pawn, Color::White);
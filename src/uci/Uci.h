@@ -1,10 +1,14 @@
 #ifndef CCHESS_UCI_H
 #define CCHESS_UCI_H
 
+#include "ai/CorrectionHistory.h"
 #include "ai/Eval.h"
+#include "ai/MateSolver.h"
+#include "ai/Search.h"
 #include "ai/TranspositionTable.h"
 #include "book/PolyglotBook.h"
 #include "core/Board.h"
+#include "utils/Affinity.h"
 
 #include <atomic>
 #include <cstdint>
@@ -20,6 +24,14 @@ class Uci {
 public:
     void loop();
 
+    // Applies the arguments of a "position" command ("startpos|fen <FEN> [moves ...]") to
+    // board, recording the hash before each move in history for repetition detection.
+    static void parsePosition(std::istringstream& args, Board& board,
+                              std::vector<uint64_t>& history);
+
+    // Formats a search report as a UCI "info" line body (without the leading "info").
+    static std::string formatInfo(const SearchInfo& info);
+
 private:
     void handleUci();
     void handleIsReady();
@@ -29,19 +41,30 @@ private:
     void handleStop();
     void handleSetOption(std::istringstream& args);
     void handleEval();
+    void handleTTStats();
 
     void joinSearch();
+    void placeSearchThread(const ThreadPlacement& placement);
 
     Board board_;
     std::vector<uint64_t> gameHistory_;
     TranspositionTable tt_;
     std::unique_ptr<eval::PawnTable> pawnTable_ = std::make_unique<eval::PawnTable>();
+    std::unique_ptr<CorrectionHistory> correction_ = std::make_unique<CorrectionHistory>();
     std::atomic<bool> stopFlag_{false};
     std::thread searchThread_;
+    bool infiniteSearch_ = false;  // the last go was "go infinite": bestmove waits for stop
 
     book::PolyglotBook book_;
     bool useOwnBook_ = false;
     int bookDepth_ = 10;  // stop consulting book after this many moves
+
+    std::string traceFile_;  // search trace written here after each search; empty = off
+
+    std::unique_ptr<MateSolver> mateSolver_;  // "go mate N"; allocated on first use
+
+    ThreadPlacement placement_;  // CpuAffinity option; off by default
+    int tablesNode_ = -1;        // NUMA node the hash tables were last moved to
 };
 
 }  // namespace cchess
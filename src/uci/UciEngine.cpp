@@ -1,5 +1,8 @@
 #include "uci/UciEngine.h"
 
+#include "ai/Eval.h"
+
+#include <sstream>
 #include <stdexcept>
 
 #ifdef _WIN32
@@ -190,7 +193,17 @@ void UciEngine::newGame() {
 
 std::string UciEngine::go(const std::string& params) {
     send("go " + params);
-    std::string line = readUntil("bestmove");
+    lastScore_.reset();
+    std::string line;
+    while (true) {
+        line = readLine();
+        if (line.rfind("bestmove", 0) == 0)
+            break;
+        if (line.rfind("info", 0) == 0) {
+            if (auto score = parseInfoScore(line))
+                lastScore_ = score;
+        }
+    }
     // "bestmove e2e4 ponder d7d5" -> extract "e2e4"
     auto pos = line.find(' ');
     if (pos == std::string::npos)
@@ -201,4 +214,25 @@ std::string UciEngine::go(const std::string& params) {
     return line.substr(pos + 1, end - pos - 1);
 }
 
+std::optional<int> parseInfoScore(const std::string& line) {
+    std::istringstream iss(line);
+    std::string token;
+    while (iss >> token) {
+        if (token != "score")
+            continue;
+        std::string kind;
+        int value = 0;
+        if (!(iss >> kind >> value))
+            return std::nullopt;
+        if (kind == "cp")
+            return value;
+        if (kind == "mate") {
+            // "mate 3": mates in 3 moves (5 plies); "mate -3": mated in 3 (6 plies)
+            return value > 0 ? eval::SCORE_MATE - (2 * value - 1) : -eval::SCORE_MATE - 2 * value;
+        }
+        return std::nullopt;
+    }
+    return std::nullopt;
+}
+
 }  // namespace cchess
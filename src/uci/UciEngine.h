@@ -3,6 +3,7 @@
 
 #include <cstdio>
 #include <map>
+#include <optional>
 #include <string>
 
 namespace cchess {
@@ -25,9 +26,14 @@ public:
     void newGame();
     std::string go(const std::string& params);
 
+    // Score of the last "info ... score" line seen during go(), side-to-move
+    // relative; empty when the engine sent none.
+    std::optional<int> lastScore() const { return lastScore_; }
+
 private:
     FILE* toEngine_ = nullptr;
     FILE* fromEngine_ = nullptr;
+    std::optional<int> lastScore_;
 #ifdef _WIN32
     void* processHandle_ = nullptr;
     void* threadHandle_ = nullptr;
@@ -36,6 +42,10 @@ private:
 #endif
 };
 
+// Score in centipawns from a UCI "info" line, or empty when it has none. Mate
+// scores map to +/-(SCORE_MATE - plies), as CChess reports them internally.
+std::optional<int> parseInfoScore(const std::string& line);
+
 }  // namespace cchess
 
 #endif  // CCHESS_UCI_ENGINE_H
@@ -0,0 +1,217 @@
+#include "utils/Affinity.h"
+
+#include "utils/Error.h"
+#include "utils/StringUtils.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdint>
+#endif
+
+namespace cchess {
+
+namespace {
+
+#ifdef __linux__
+// From <linux/mempolicy.h>, which is not always installed
+constexpr int MPOL_PREFERRED_MODE = 1;
+constexpr unsigned MPOL_MF_MOVE_FLAG = 1u << 1;
+
+std::string readFirstLine(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return trim(line);
+}
+
+CpuTopology detectTopology() {
+    CpuTopology topology;
+    if (DIR* dir = ::opendir("/sys/devices/system/node")) {
+        while (dirent* entry = ::readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name.rfind("node", 0) != 0 || !isInteger(name.substr(4)))
+                continue;
+            std::string list = readFirstLine("/sys/devices/system/node/" + name + "/cpulist");
+            try {
+                std::vector<int> cpus = parseCpuList(list);
+                if (!cpus.empty())
+                    topology.nodes.push_back({toInteger(name.substr(4)), std::move(cpus)});
+            } catch (const ChessError&) {
+            }
+        }
+        ::closedir(dir);
+    }
+    std::sort(topology.nodes.begin(), topology.nodes.end(),
+              [](const CpuTopology::Node& a, const CpuTopology::Node& b) { return a.id < b.id; });
+
+    if (topology.nodes.empty()) {
+        std::vector<int> cpus;
+        try {
+            cpus = parseCpuList(readFirstLine("/sys/devices/system/cpu/online"));
+        } catch (const ChessError&) {
+        }
+        if (cpus.empty()) {
+            for (unsigned i = 0; i < std::max(1u, std::thread::hardware_concurrency()); ++i)
+                cpus.push_back(static_cast<int>(i));
+        }
+        topology.nodes.push_back({0, std::move(cpus)});
+    }
+    return topology;
+}
+#else
+CpuTopology detectTopology() {
+    CpuTopology topology;
+    std::vector<int> cpus;
+    for (unsigned i = 0; i < std::max(1u, std::thread::hardware_concurrency()); ++i)
+        cpus.push_back(static_cast<int>(i));
+    topology.nodes.push_back({0, std::move(cpus)});
+    return topology;
+}
+#endif
+
+}  // namespace
+
+const CpuTopology& CpuTopology::get() {
+    static const CpuTopology topology = detectTopology();
+    return topology;
+}
+
+int CpuTopology::nodeOf(int cpu) const {
+    for (const auto& node : nodes) {
+        if (std::find(node.cpus.begin(), node.cpus.end(), cpu) != node.cpus.end())
+            return node.id;
+    }
+    return -1;
+}
+
+size_t CpuTopology::cpuCount() const {
+    size_t count = 0;
+    for (const auto& node : nodes)
+        count += node.cpus.size();
+    return count;
+}
+
+std::vector<int> parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    for (const std::string& part : split(list, ',')) {
+        std::string range = trim(part);
+        if (range.empty())
+            continue;
+        auto dash = range.find('-');
+        std::string first = dash == std::string::npos ? range : range.substr(0, dash);
+        std::string last = dash == std::string::npos ? range : range.substr(dash + 1);
+        if (!isInteger(first) || !isInteger(last) || toInteger(first) < 0 ||
+            toInteger(last) < toInteger(first))
+            throw ChessError("Invalid CPU list: " + list);
+        for (int cpu = toInteger(first); cpu <= toInteger(last); ++cpu)
+            cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+ThreadPlacement ThreadPlacement::parse(const std::string& spec) {
+    ThreadPlacement placement;
+    std::string s = trim(spec);
+    if (s.empty() || s == "off" || s == "<empty>")
+        return placement;
+
+    if (s == "auto") {
+        // Round-robin over nodes: node 0's first CPU, node 1's first CPU, ...
+        const CpuTopology& topology = CpuTopology::get();
+        for (size_t i = 0; placement.cpus_.size() < topology.cpuCount(); ++i) {
+            for (const auto& node : topology.nodes) {
+                if (i < node.cpus.size())
+                    placement.cpus_.push_back(node.cpus[i]);
+            }
+        }
+    } else {
+        placement.cpus_ = parseCpuList(s);
+        if (placement.cpus_.empty())
+            throw ChessError("Empty CPU list: " + spec);
+    }
+    return placement;
+}
+
+int ThreadPlacement::cpuFor(size_t threadIndex) const {
+    if (cpus_.empty())
+        return -1;
+    return cpus_[threadIndex % cpus_.size()];
+}
+
+int ThreadPlacement::pinCurrentThread(size_t threadIndex) const {
+    int cpu = cpuFor(threadIndex);
+    if (cpu < 0 || !cchess::pinCurrentThread(cpu))
+        return -1;
+    return cpu;
+}
+
+std::string ThreadPlacement::describe() const {
+    if (cpus_.empty())
+        return "off";
+    std::ostringstream out;
+    for (size_t i = 0; i < cpus_.size(); ++i)
+        out << (i > 0 ? "," : "") << cpus_[i];
+    return out.str();
+}
+
+#ifdef __linux__
+bool pinCurrentThread(int cpu) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+        return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<size_t>(cpu), &set);
+    return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+}
+
+int currentCpu() {
+    return ::sched_getcpu();
+}
+
+bool bindMemoryToNode(void* addr, size_t bytes, int node) {
+#ifdef SYS_mbind
+    if (node < 0 || node >= 64 || CpuTopology::get().nodes.size() < 2)
+        return false;
+    long pageSize = ::sysconf(_SC_PAGESIZE);
+    if (pageSize <= 0)
+        return false;
+    auto page = static_cast<uintptr_t>(pageSize);
+    uintptr_t begin = (reinterpret_cast<uintptr_t>(addr) + page - 1) & ~(page - 1);
+    uintptr_t end = (reinterpret_cast<uintptr_t>(addr) + bytes) & ~(page - 1);
+    if (end <= begin)
+        return false;
+    unsigned long mask = 1UL << node;
+    return ::syscall(SYS_mbind, begin, end - begin, MPOL_PREFERRED_MODE, &mask,
+                     sizeof(mask) * 8 + 1, MPOL_MF_MOVE_FLAG) == 0;
+#else
+    (void)addr;
+    (void)bytes;
+    (void)node;
+    return false;
+#endif
+}
+#else
+bool pinCurrentThread(int) {
+    return false;
+}
+
+int currentCpu() {
+    return -1;
+}
+
+bool bindMemoryToNode(void*, size_t, int) {
+    return false;
+}
+#endif
+
+}  // namespace cchess
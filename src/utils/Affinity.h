@@ -0,0 +1,69 @@
+#ifndef CCHESS_AFFINITY_H
+#define CCHESS_AFFINITY_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace cchess {
+
+// Online CPUs grouped by NUMA node, read once from sysfs. Where sysfs has no
+// node information (other OSes, single-node kernels) every CPU is in node 0.
+struct CpuTopology {
+    struct Node {
+        int id;
+        std::vector<int> cpus;
+    };
+    std::vector<Node> nodes;  // ascending id
+
+    static const CpuTopology& get();
+
+    int nodeOf(int cpu) const;  // node id, or -1 for an unknown CPU
+    size_t cpuCount() const;
+};
+
+// Parses a Linux-style CPU list such as "0-3,8,10-11". Throws ChessError when malformed.
+std::vector<int> parseCpuList(const std::string& list);
+
+// Which CPU each thread of a pool runs on.
+//
+// Off by default (the scheduler decides). "auto" spreads threads round-robin
+// over the NUMA nodes, so a pool smaller than the machine still uses every
+// memory controller; an explicit CPU list assigns its CPUs in order. Either way
+// thread i gets the (i mod count)-th CPU.
+class ThreadPlacement {
+public:
+    ThreadPlacement() = default;
+
+    // "", "off", "auto" or a CPU list. Throws ChessError when malformed.
+    static ThreadPlacement parse(const std::string& spec);
+
+    bool enabled() const { return !cpus_.empty(); }
+    int cpuFor(size_t threadIndex) const;  // -1 when disabled
+
+    // Pins the calling thread as thread threadIndex. Returns the CPU, or -1 when
+    // placement is off or the OS refused.
+    int pinCurrentThread(size_t threadIndex) const;
+
+    std::string describe() const;
+
+private:
+    std::vector<int> cpus_;
+};
+
+// Pins the calling thread to one CPU; false where unsupported or refused.
+bool pinCurrentThread(int cpu);
+
+// CPU the calling thread is running on, or -1 when unknown.
+int currentCpu();
+
+// Moves the whole pages of [addr, addr + bytes) to a NUMA node and keeps later
+// allocations there (mbind with MPOL_PREFERRED | MPOL_MF_MOVE). Memory that is
+// first touched by a pinned thread is already local; this is for tables that
+// were allocated before their user was placed. Returns false on single-node
+// machines and where the call is unsupported.
+bool bindMemoryToNode(void* addr, size_t bytes, int node);
+
+}  // namespace cchess
+
+#endif  // CCHESS_AFFINITY_H
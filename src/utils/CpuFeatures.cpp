@@ -0,0 +1,132 @@
+#include "utils/CpuFeatures.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace cchess {
+
+namespace {
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+CpuFeatures detectFeatures() {
+    __builtin_cpu_init();
+    CpuFeatures f;
+    f.popcnt = __builtin_cpu_supports("popcnt");
+    f.sse42 = __builtin_cpu_supports("sse4.2");
+    f.bmi1 = __builtin_cpu_supports("bmi");
+    f.bmi2 = __builtin_cpu_supports("bmi2");
+    f.avx2 = __builtin_cpu_supports("avx2");
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 12
+    // The same test the target_clones resolver makes
+    if (__builtin_cpu_supports("x86-64-v3"))
+        f.level = IsaLevel::X86_64_V3;
+    else if (__builtin_cpu_supports("x86-64-v2"))
+        f.level = IsaLevel::X86_64_V2;
+    else
+        f.level = IsaLevel::X86_64;
+#else
+    if (f.popcnt && f.sse42 && f.bmi1 && f.bmi2 && f.avx2)
+        f.level = IsaLevel::X86_64_V3;
+    else if (f.popcnt && f.sse42)
+        f.level = IsaLevel::X86_64_V2;
+    else
+        f.level = IsaLevel::X86_64;
+#endif
+    return f;
+}
+#else
+CpuFeatures detectFeatures() {
+    return {};
+}
+#endif
+
+}  // namespace
+
+const char* isaLevelName(IsaLevel level) {
+    switch (level) {
+        case IsaLevel::Generic:
+            return "generic";
+        case IsaLevel::X86_64:
+            return "x86-64";
+        case IsaLevel::X86_64_V2:
+            return "x86-64-v2";
+        case IsaLevel::X86_64_V3:
+            return "x86-64-v3";
+    }
+    return "unknown";
+}
+
+const CpuFeatures& CpuFeatures::get() {
+    static const CpuFeatures features = detectFeatures();
+    return features;
+}
+
+IsaLevel compiledIsaLevel() {
+#if !defined(__x86_64__) && !defined(_M_X64)
+    return IsaLevel::Generic;
+#elif defined(__AVX2__) && defined(__BMI2__)
+    return IsaLevel::X86_64_V3;
+#elif defined(__POPCNT__) && defined(__SSE4_2__)
+    return IsaLevel::X86_64_V2;
+#else
+    return IsaLevel::X86_64;
+#endif
+}
+
+bool isaDispatchEnabled() {
+#ifdef CCHESS_ISA_DISPATCH
+    return true;
+#else
+    return false;
+#endif
+}
+
+IsaLevel activeIsaLevel() {
+    if (!isaDispatchEnabled())
+        return compiledIsaLevel();
+    return std::max(CpuFeatures::get().level, compiledIsaLevel());
+}
+
+std::string describeIsa() {
+    const CpuFeatures& cpu = CpuFeatures::get();
+    std::string text = isaLevelName(activeIsaLevel());
+    text += isaDispatchEnabled() ? " (dispatched; cpu" : " (compiled; cpu";
+    if (cpu.popcnt)
+        text += " popcnt";
+    if (cpu.bmi2)
+        text += " bmi2";
+    if (cpu.avx2)
+        text += " avx2";
+    if (!cpu.popcnt && !cpu.bmi2 && !cpu.avx2)
+        text += " baseline";
+    return text + ")";
+}
+
+size_t l2CacheBytes() {
+#ifdef __linux__
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    long size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (size > 0)
+        return static_cast<size_t>(size);
+#endif
+    // e.g. "2048K"
+    std::ifstream file("/sys/devices/system/cpu/cpu0/cache/index2/size");
+    size_t value = 0;
+    char unit = 0;
+    if (file >> value) {
+        if (file >> unit && (unit == 'K' || unit == 'k'))
+            value *= 1024;
+        else if (unit == 'M' || unit == 'm')
+            value *= 1024 * 1024;
+        return value;
+    }
+#endif
+    return 0;
+}
+
+}  // namespace cchess
@@ -0,0 +1,62 @@
+#ifndef CCHESS_CPU_FEATURES_H
+#define CCHESS_CPU_FEATURES_H
+
+#include <cstddef>
+#include <string>
+
+// Hot kernels (move generation, check detection, evaluation) are marked with
+// CCHESS_MULTIVERSION. When the build has ISA dispatch (ENABLE_ISA_DISPATCH and
+// a compiler with target_clones), each one is compiled for baseline x86-64,
+// x86-64-v2 (POPCNT, SSE4.2) and x86-64-v3 (BMI1/2, AVX2), and the loader picks
+// one clone per function from cpuid before main() runs. Calls between marked
+// functions in one file go straight to the clone of the same level, but marked
+// functions are never inlined, so only mark entry points that are out of line
+// anyway.
+#ifdef CCHESS_ISA_DISPATCH
+#define CCHESS_MULTIVERSION \
+    __attribute__((target_clones("default", "arch=x86-64-v2", "arch=x86-64-v3")))
+#else
+#define CCHESS_MULTIVERSION
+#endif
+
+namespace cchess {
+
+enum class IsaLevel {
+    Generic,  // not x86-64
+    X86_64,
+    X86_64_V2,
+    X86_64_V3,
+};
+
+const char* isaLevelName(IsaLevel level);
+
+// What cpuid reports for the running CPU (all false off x86-64).
+struct CpuFeatures {
+    bool popcnt = false;
+    bool sse42 = false;
+    bool bmi1 = false;
+    bool bmi2 = false;
+    bool avx2 = false;
+    IsaLevel level = IsaLevel::Generic;  // highest level this CPU runs
+
+    static const CpuFeatures& get();
+};
+
+// Level the build targets without dispatch (its -march).
+IsaLevel compiledIsaLevel();
+
+// Level the hot kernels run at: the CPU's level when dispatching, otherwise the
+// compiled level.
+IsaLevel activeIsaLevel();
+
+bool isaDispatchEnabled();
+
+// One line for banners, e.g. "x86-64-v3 (dispatched; cpu popcnt bmi2 avx2)".
+std::string describeIsa();
+
+// Per-core L2 cache size in bytes, or 0 when the platform does not report it.
+size_t l2CacheBytes();
+
+}  // namespace cchess
+
+#endif  // CCHESS_CPU_FEATURES_H
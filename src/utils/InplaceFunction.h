@@ -0,0 +1,120 @@
+#ifndef CCHESS_INPLACE_FUNCTION_H
+#define CCHESS_INPLACE_FUNCTION_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cchess {
+
+template <typename Signature, size_t Capacity = 64>
+class InplaceFunction;
+
+// Drop-in replacement for std::function that stores the callable in a fixed
+// buffer and never allocates. A callable that does not fit is a compile error
+// rather than a silent heap fallback; capture by reference to stay small.
+template <typename R, typename... Args, size_t Capacity>
+class InplaceFunction<R(Args...), Capacity> {
+public:
+    InplaceFunction() = default;
+    InplaceFunction(std::nullptr_t) {}
+
+    template <typename F,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InplaceFunction>>>
+    InplaceFunction(F&& f) {
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= Capacity, "callable too large for InplaceFunction");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "callable over-aligned");
+        static_assert(std::is_invocable_r_v<R, Fn&, Args...>, "callable has wrong signature");
+
+        ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(f));
+        invoke_ = [](void* self, Args... args) -> R {
+            return (*static_cast<Fn*>(self))(std::forward<Args>(args)...);
+        };
+        manage_ = [](Op op, void* dst, void* src) {
+            switch (op) {
+                case Op::Copy:
+                    ::new (dst) Fn(*static_cast<const Fn*>(src));
+                    break;
+                case Op::Move:
+                    ::new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+                    static_cast<Fn*>(src)->~Fn();
+                    break;
+                case Op::Destroy:
+                    static_cast<Fn*>(dst)->~Fn();
+                    break;
+            }
+        };
+    }
+
+    InplaceFunction(const InplaceFunction& other) { copyFrom(other); }
+    InplaceFunction(InplaceFunction&& other) noexcept { moveFrom(other); }
+
+    InplaceFunction& operator=(const InplaceFunction& other) {
+        if (this != &other) {
+            reset();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(std::nullptr_t) {
+        reset();
+        return *this;
+    }
+
+    ~InplaceFunction() { reset(); }
+
+    explicit operator bool() const { return invoke_ != nullptr; }
+
+    R operator()(Args... args) const {
+        return invoke_(static_cast<void*>(storage_), std::forward<Args>(args)...);
+    }
+
+private:
+    enum class Op { Copy, Move, Destroy };
+
+    void copyFrom(const InplaceFunction& other) {
+        if (other.invoke_) {
+            other.manage_(Op::Copy, storage_, other.storage_);
+            invoke_ = other.invoke_;
+            manage_ = other.manage_;
+        }
+    }
+
+    void moveFrom(InplaceFunction& other) {
+        if (other.invoke_) {
+            other.manage_(Op::Move, storage_, other.storage_);
+            invoke_ = other.invoke_;
+            manage_ = other.manage_;
+            other.invoke_ = nullptr;
+            other.manage_ = nullptr;
+        }
+    }
+
+    void reset() {
+        if (invoke_) {
+            manage_(Op::Destroy, storage_, nullptr);
+            invoke_ = nullptr;
+            manage_ = nullptr;
+        }
+    }
+
+    // mutable: like std::function, a const wrapper may call a stateful callable
+    alignas(std::max_align_t) mutable unsigned char storage_[Capacity];
+    R (*invoke_)(void*, Args...) = nullptr;
+    void (*manage_)(Op, void*, void*) = nullptr;
+};
+
+}  // namespace cchess
+
+#endif  // CCHESS_INPLACE_FUNCTION_H
@@ -0,0 +1,39 @@
+#include "utils/MemoryUsage.h"
+
+#include "ai/TranspositionTable.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace cchess {
+
+size_t peakRssBytes() {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss);  // bytes
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;  // kilobytes
+#endif
+#else
+    return 0;
+#endif
+}
+
+bool lowMemoryBuild() {
+#ifdef CCHESS_LOW_MEMORY
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::string describeMemoryProfile() {
+    return std::string(lowMemoryBuild() ? "low-memory" : "default") + " (hash " +
+           std::to_string(TranspositionTable::DEFAULT_SIZE_MB) + " MB)";
+}
+
+}  // namespace cchess
@@ -0,0 +1,22 @@
+#ifndef CCHESS_MEMORY_USAGE_H
+#define CCHESS_MEMORY_USAGE_H
+
+#include <cstddef>
+#include <string>
+
+namespace cchess {
+
+// Peak resident set size of the process so far, in bytes; 0 where the
+// platform does not report it.
+size_t peakRssBytes();
+
+// True in ENABLE_LOW_MEMORY builds (small default hash and pawn tables,
+// compact magic tables).
+bool lowMemoryBuild();
+
+// "low-memory" or "default", with the default hash size, e.g. "default (hash 512 MB)".
+std::string describeMemoryProfile();
+
+}  // namespace cchess
+
+#endif  // CCHESS_MEMORY_USAGE_H
@@ -0,0 +1,178 @@
+#include "utils/PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace cchess {
+
+PerfReading PerfReading::since(const PerfReading& earlier) const {
+    PerfReading diff;
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+        if (values[i] && earlier.values[i] && *values[i] >= *earlier.values[i])
+            diff.values[i] = *values[i] - *earlier.values[i];
+    }
+    return diff;
+}
+
+std::optional<double> PerfReading::ipc() const {
+    auto cycles = (*this)[PerfEvent::Cycles];
+    auto instructions = (*this)[PerfEvent::Instructions];
+    if (!cycles || !instructions || *cycles == 0)
+        return std::nullopt;
+    return static_cast<double>(*instructions) / static_cast<double>(*cycles);
+}
+
+const char* PerfCounters::name(PerfEvent e) {
+    switch (e) {
+        case PerfEvent::Cycles:
+            return "cycles";
+        case PerfEvent::Instructions:
+            return "instructions";
+        case PerfEvent::L1dMisses:
+            return "l1d_misses";
+        case PerfEvent::LlcMisses:
+            return "llc_misses";
+        case PerfEvent::DtlbMisses:
+            return "dtlb_misses";
+        case PerfEvent::BranchMisses:
+            return "branch_misses";
+        default:
+            return "unknown";
+    }
+}
+
+#ifdef __linux__
+
+namespace {
+
+// Cache event config: cache id | (operation << 8) | (result << 16)
+constexpr uint64_t cacheReadMiss(uint64_t cache) {
+    return cache | (uint64_t{PERF_COUNT_HW_CACHE_OP_READ} << 8) |
+           (uint64_t{PERF_COUNT_HW_CACHE_RESULT_MISS} << 16);
+}
+
+int openEvent(uint32_t type, uint64_t config) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // Calling thread, any CPU, no group
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+}  // namespace
+
+PerfCounters::PerfCounters() {
+    struct Spec {
+        uint32_t type;
+        uint64_t config;
+    };
+    const std::array<Spec, PERF_EVENT_COUNT> specs = {{
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HW_CACHE, cacheReadMiss(PERF_COUNT_HW_CACHE_L1D)},
+        {PERF_TYPE_HW_CACHE, cacheReadMiss(PERF_COUNT_HW_CACHE_LL)},
+        {PERF_TYPE_HW_CACHE, cacheReadMiss(PERF_COUNT_HW_CACHE_DTLB)},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    }};
+
+    int firstError = 0;
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+        fds_[i] = openEvent(specs[i].type, specs[i].config);
+        if (fds_[i] < 0 && firstError == 0)
+            firstError = errno;
+    }
+
+    if (!available()) {
+        reason_ = std::string("perf_event_open failed: ") + std::strerror(firstError);
+        if (firstError == EACCES || firstError == EPERM)
+            reason_ += " (check /proc/sys/kernel/perf_event_paranoid or CAP_PERFMON)";
+        else if (firstError == ENOENT || firstError == ENODEV)
+            reason_ += " (no hardware PMU exposed, e.g. in a VM)";
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds_) {
+        if (fd >= 0)
+            ::close(fd);
+    }
+}
+
+bool PerfCounters::available() const {
+    for (int fd : fds_) {
+        if (fd >= 0)
+            return true;
+    }
+    return false;
+}
+
+void PerfCounters::start() {
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+void PerfCounters::stop() {
+    for (int fd : fds_) {
+        if (fd >= 0)
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+}
+
+PerfReading PerfCounters::read() const {
+    PerfReading reading;
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+        if (fds_[i] < 0)
+            continue;
+        uint64_t data[3] = {};  // value, time enabled, time running
+        if (::read(fds_[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)))
+            continue;
+        if (data[2] == 0)
+            continue;  // never scheduled on the PMU
+        if (data[2] < data[1]) {
+            double scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+            data[0] = static_cast<uint64_t>(static_cast<double>(data[0]) * scale);
+        }
+        reading.values[i] = data[0];
+    }
+    return reading;
+}
+
+#else
+
+PerfCounters::PerfCounters() : reason_("hardware counters are only supported on Linux") {
+    fds_.fill(-1);
+}
+
+PerfCounters::~PerfCounters() = default;
+
+bool PerfCounters::available() const {
+    return false;
+}
+
+void PerfCounters::start() {}
+
+void PerfCounters::stop() {}
+
+PerfReading PerfCounters::read() const {
+    return {};
+}
+
+#endif  // __linux__
+
+}  // namespace cchess
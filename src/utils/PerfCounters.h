@@ -0,0 +1,75 @@
+#ifndef CCHESS_PERF_COUNTERS_H
+#define CCHESS_PERF_COUNTERS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace cchess {
+
+enum class PerfEvent : size_t {
+    Cycles,
+    Instructions,
+    L1dMisses,
+    LlcMisses,
+    DtlbMisses,
+    BranchMisses,
+    Count
+};
+
+constexpr size_t PERF_EVENT_COUNT = static_cast<size_t>(PerfEvent::Count);
+
+// Snapshot of the counters. An event the kernel or CPU would not count is nullopt.
+struct PerfReading {
+    std::array<std::optional<uint64_t>, PERF_EVENT_COUNT> values{};
+
+    std::optional<uint64_t> operator[](PerfEvent e) const {
+        return values[static_cast<size_t>(e)];
+    }
+
+    // Per-event difference (this - earlier); events missing from either side stay missing
+    PerfReading since(const PerfReading& earlier) const;
+
+    // Instructions per cycle, when both events were counted
+    std::optional<double> ipc() const;
+};
+
+// Hardware performance counters for the calling thread (Linux perf_event_open).
+//
+// Each event is opened on its own so that one unsupported event (common for
+// dTLB on virtual machines) does not disable the rest, and user-space only so
+// the default perf_event_paranoid setting allows it. When the kernel
+// multiplexes more events than the PMU has counters, readings are scaled by
+// time enabled / time running. Where counters are unavailable (other OSes,
+// containers without CAP_PERFMON, paranoid level 3) available() is false and
+// reason() says why; callers just omit the numbers.
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const;
+    const std::string& reason() const { return reason_; }
+
+    // Resets and starts counting / stops counting
+    void start();
+    void stop();
+
+    // Current counts since start()
+    PerfReading read() const;
+
+    static const char* name(PerfEvent e);
+
+private:
+    std::array<int, PERF_EVENT_COUNT> fds_{};
+    std::string reason_;
+};
+
+}  // namespace cchess
+
+#endif  // CCHESS_PERF_COUNTERS_H
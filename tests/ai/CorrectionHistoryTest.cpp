@@ -0,0 +1,54 @@
+#include "ai/CorrectionHistory.h"
+#include "core/Board.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+
+using namespace cchess;
+
+namespace {
+
+const char* START = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+const char* START_BLACK = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR b KQkq - 0 1";
+const char* ENDGAME = "8/5k2/8/3p4/3P4/8/5K2/8 w - - 0 1";
+
+}  // namespace
+
+TEST_CASE("CorrectionHistory: empty table leaves the eval unchanged", "[correction]") {
+    auto ch = std::make_unique<CorrectionHistory>();
+    Board board(START);
+    CHECK(ch->correct(board.position(), 37) == 37);
+    CHECK(ch->correct(board.position(), -120) == -120);
+}
+
+TEST_CASE("CorrectionHistory: learns toward the search score per side", "[correction]") {
+    auto ch = std::make_unique<CorrectionHistory>();
+    Board white(START);
+    Board black(START_BLACK);
+
+    for (int i = 0; i < 200; ++i)
+        ch->update(white.position(), 10, 0, 40);
+
+    int corrected = ch->correct(white.position(), 0);
+    CHECK(corrected > 0);
+    CHECK(corrected <= 40);
+    // Keyed by side to move: the same structure with the other side to move is untouched
+    CHECK(ch->correct(black.position(), 0) == 0);
+    // A different pawn structure and material configuration is untouched too
+    CHECK(ch->correct(Board(ENDGAME).position(), 0) == 0);
+
+    ch->clear();
+    CHECK(ch->correct(white.position(), 0) == 0);
+}
+
+TEST_CASE("CorrectionHistory: correction stays bounded", "[correction]") {
+    auto ch = std::make_unique<CorrectionHistory>();
+    Board board(START);
+
+    for (int i = 0; i < 1000; ++i)
+        ch->update(board.position(), 20, 0, -5000);
+
+    int limit = CorrectionHistory::LIMIT / CorrectionHistory::GRAIN;
+    CHECK(ch->correct(board.position(), 0) >= -limit);
+    CHECK(ch->correct(board.position(), 0) < 0);
+}
@@ -0,0 +1,53 @@
+#include "ai/InterleavedSearch.h"
+#include "ai/PawnTable.h"
+#include "ai/Search.h"
+#include "ai/SearchConfig.h"
+#include "ai/TranspositionTable.h"
+#include "core/Board.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+using namespace cchess;
+
+static const std::vector<std::string> FENS = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "7k/5ppp/8/8/8/8/2R5/7K w - - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+};
+
+TEST_CASE("InterleavedSearch: matches Search node for node", "[interleaved]") {
+    // One slot per position gives every search a fresh TT, as below
+    auto results = InterleavedSearch::run(FENS, 5, FENS.size(), 4);
+    REQUIRE(results.size() == FENS.size());
+
+    for (size_t i = 0; i < FENS.size(); ++i) {
+        Board board(FENS[i]);
+        SearchConfig config;
+        config.maxDepth = 5;
+        config.searchTime = std::chrono::milliseconds(60000);
+        TranspositionTable tt(4);
+        eval::PawnTable pt;
+        CorrectionHistory ch;
+        Search search(board, config, tt, pt, ch);
+        Move best = search.findBestMove();
+
+        CHECK(results[i].bestMove == best);
+        CHECK(results[i].nodes == search.totalNodes());
+    }
+}
+
+TEST_CASE("InterleavedSearch: widths share slots across positions", "[interleaved]") {
+    auto narrow = InterleavedSearch::run(FENS, 4, 1, 4);
+    auto wide = InterleavedSearch::run(FENS, 4, 2, 4);
+    REQUIRE(narrow.size() == FENS.size());
+    REQUIRE(wide.size() == FENS.size());
+
+    // Back-rank mate is found whichever slot searches it
+    CHECK(narrow[2].bestMove.toAlgebraic() == "c2c8");
+    CHECK(wide[2].bestMove.toAlgebraic() == "c2c8");
+    for (const auto& r : wide)
+        CHECK_FALSE(r.bestMove.isNull());
+}
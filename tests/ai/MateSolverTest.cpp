@@ -0,0 +1,89 @@
+#include "ai/MateSolver.h"
+#include "core/Board.h"
+#include "core/movegen/MoveGenerator.h"
+#include "mode/MateRunner.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+
+using namespace cchess;
+
+namespace {
+
+MateResult solve(const char* fen, int maxMoves) {
+    MateSolver solver(1);
+    MateSolverConfig config;
+    config.maxMoves = maxMoves;
+    config.timeLimit = std::chrono::milliseconds(60000);
+    return solver.solve(Board(fen), config);
+}
+
+// Plays the PV and checks it ends in checkmate after 2 * mateIn - 1 plies
+bool pvMates(const char* fen, const MateResult& result) {
+    Board board(fen);
+    for (const Move& move : result.pv) {
+        if (!board.makeMove(move))
+            return false;
+    }
+    return static_cast<int>(result.pv.size()) == 2 * result.mateIn - 1 &&
+           MoveGenerator::isCheckmate(board.position());
+}
+
+}  // namespace
+
+TEST_CASE("MateSolver: back-rank mate in one", "[mate]") {
+    const char* fen = "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1";
+    MateResult result = solve(fen, 3);
+    REQUIRE(result.found);
+    CHECK(result.mateIn == 1);
+    CHECK(result.bestMove.toAlgebraic() == "d1d8");
+    CHECK(result.proofSize == 2);
+    CHECK(pvMates(fen, result));
+}
+
+TEST_CASE("MateSolver: finds the shortest mate in two", "[mate]") {
+    // 1. Ra6! bxa6 (or anything) 2. b7#
+    const char* fen = "kbK5/pp6/1P6/8/8/8/8/R7 w - - 0 1";
+    MateResult result = solve(fen, 4);
+    REQUIRE(result.found);
+    CHECK(result.mateIn == 2);
+    CHECK(result.bestMove.toAlgebraic() == "a1a6");
+    CHECK(result.proofSize > 2);
+    CHECK(pvMates(fen, result));
+}
+
+TEST_CASE("MateSolver: disproves positions without a mate", "[mate]") {
+    MateResult start = solve("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 1);
+    CHECK_FALSE(start.found);
+    CHECK(start.disproven);
+
+    // Stalemated: no move at all, and not a loss either
+    MateResult stalemate = solve("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1", 2);
+    CHECK_FALSE(stalemate.found);
+    CHECK(stalemate.disproven);
+}
+
+TEST_CASE("MateSolver: node limit leaves the result unknown", "[mate]") {
+    MateSolver solver(1);
+    MateSolverConfig config;
+    config.maxMoves = 6;
+    config.maxNodes = 2048;
+    MateResult result = solver.solve(Board(), config);
+    CHECK_FALSE(result.found);
+    CHECK_FALSE(result.disproven);
+    CHECK(result.nodes <= 2048 + 1024);
+}
+
+TEST_CASE("MateRunner: parses dm and id opcodes", "[mate]") {
+    std::istringstream in("# comment\n"
+                          "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - dm 1; id \"back rank\";\n"
+                          "kbK5/pp6/1P6/8/8/8/8/R7 w - - 0 1\n"
+                          "not a fen\n");
+    auto problems = MateRunner::parseEpd(in);
+    REQUIRE(problems.size() == 2);
+    CHECK(problems[0].expectedMoves == 1);
+    CHECK(problems[0].id == "back rank");
+    CHECK(problems[0].fen == "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1");
+    CHECK(problems[1].expectedMoves == 0);
+    CHECK(problems[1].id == "line 3");
+}
@@ -4,8 +4,12 @@
 #include "ai/TranspositionTable.h"
 #include "core/Board.h"
 #include "core/Move.h"
+#include "support/AllocationCounter.h"
 
+#include <atomic>
 #include <catch2/catch_test_macros.hpp>
+#include <future>
+#include <memory>
 
 using namespace cchess;
 
@@ -17,7 +21,8 @@ static Move bestMove(const std::string& fen, int depth) {
     config.searchTime = std::chrono::milliseconds(10000);
     TranspositionTable tt(16);
     eval::PawnTable pt;
-    Search search(board, config, tt, pt);
+    CorrectionHistory ch;
+    Search search(board, config, tt, pt, ch);
     return search.findBestMove();
 }
 
@@ -51,3 +56,136 @@ TEST_CASE("Search: rook skewer — wins queen", "[search]") {
     Move best = bestMove("6q1/8/6k1/8/7R/8/8/K7 w - - 0 1", 4);
     CHECK(movesSquares(best, "h4", "g4"));
 }
+
+TEST_CASE("Search: node limit stops the search", "[search]") {
+    Board board;
+    SearchConfig config;
+    config.maxDepth = 64;
+    config.maxNodes = 20000;
+    config.searchTime = std::chrono::milliseconds(60000);
+    TranspositionTable tt(16);
+    eval::PawnTable pt;
+    CorrectionHistory ch;
+    Search search(board, config, tt, pt, ch);
+    Move best = search.findBestMove();
+
+    CHECK_FALSE(best.isNull());
+    // checkTime() polls every 1024 nodes, so allow one polling interval of overshoot
+    CHECK(search.totalNodes() <= config.maxNodes + 1024);
+}
+
+TEST_CASE("Search: pondering suspends the time limit until the ponder hit", "[search]") {
+    Board board;
+    SearchConfig config;
+    config.maxDepth = 64;
+    config.searchTime = std::chrono::milliseconds(1);
+    std::atomic<bool> stop{false};
+    std::atomic<bool> pondering{true};
+    config.stopSignal = &stop;
+    config.ponderSignal = &pondering;
+    TranspositionTable tt(16);
+    eval::PawnTable pt;
+    CorrectionHistory ch;
+
+    auto result = std::async(std::launch::async, [&]() {
+        Search search(board, config, tt, pt, ch);
+        return search.findBestMove();
+    });
+
+    // A 1 ms budget would long be spent; while pondering the search must keep going
+    CHECK(result.wait_for(std::chrono::milliseconds(200)) == std::future_status::timeout);
+
+    // Ponder hit: the 1 ms budget now starts, so the search finishes promptly
+    pondering.store(false);
+    bool finished = result.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+    if (!finished)
+        stop.store(true);
+    CHECK(finished);
+    CHECK_FALSE(result.get().isNull());
+}
+
+TEST_CASE("Search: infinite search runs until stopped and reports progress", "[search]") {
+    Board board;
+    SearchConfig config;
+    config.infinite = true;
+    config.maxDepth = MAX_SEARCH_DEPTH;
+    config.searchTime = std::chrono::milliseconds(1);  // ignored
+    config.progressInterval = std::chrono::milliseconds(20);
+    std::atomic<bool> stop{false};
+    config.stopSignal = &stop;
+    TranspositionTable tt(16);
+    eval::PawnTable pt;
+    CorrectionHistory ch;
+
+    std::atomic<int> progress{0};
+    std::atomic<int> lastDepth{0};
+    auto result = std::async(std::launch::async, [&]() {
+        Search search(board, config, tt, pt, ch, [&](const SearchInfo& info) {
+            if (info.partial && info.hashfull >= 0 && info.pv.empty()) {
+                ++progress;
+            } else if (!info.partial) {
+                lastDepth.store(info.depth);
+            }
+        });
+        return search.findBestMove();
+    });
+
+    CHECK(result.wait_for(std::chrono::milliseconds(300)) == std::future_status::timeout);
+    stop.store(true);
+    bool finished = result.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+    CHECK(finished);
+    CHECK_FALSE(result.get().isNull());
+    CHECK(progress.load() > 0);
+    CHECK(lastDepth.load() > 0);
+}
+
+TEST_CASE("Search: iterations stop at MAX_SEARCH_DEPTH", "[search]") {
+    // Bare kings: every child is a draw, so each iteration is instant
+    Board board("8/8/4k3/8/8/4K3/8/8 w - - 0 1");
+    SearchConfig config;
+    config.maxDepth = 1000;
+    config.searchTime = std::chrono::milliseconds(60000);
+    TranspositionTable tt(16);
+    eval::PawnTable pt;
+    CorrectionHistory ch;
+
+    int lastDepth = 0;
+    Search search(board, config, tt, pt, ch,
+                  [&](const SearchInfo& info) { lastDepth = info.depth; });
+    CHECK_FALSE(search.findBestMove().isNull());
+    CHECK(lastDepth == MAX_SEARCH_DEPTH);
+}
+
+TEST_CASE("Search: no heap allocation after warm-up", "[search]") {
+    Board board("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q2/PPPBBPPP/R3K2R w KQkq - 0 1");
+    SearchConfig config;
+    config.maxDepth = 6;
+    config.searchTime = std::chrono::milliseconds(60000);
+    TranspositionTable tt(16);
+    eval::PawnTable pt;
+    CorrectionHistory ch;
+
+    SearchInfo last;
+    int reports = 0;
+    Search search(board, config, tt, pt, ch, [&](const SearchInfo& info) {
+        last = info;
+        ++reports;
+    });
+    search.findBestMove();  // warm-up: first-use statics and lazily built tables
+
+    {
+        test::AllocationScope probe;  // the hook itself must see allocations
+        auto boxed = std::make_unique<int>(1);
+        REQUIRE(probe.count() == 1);
+    }
+
+    reports = 0;
+    test::AllocationScope scope;
+    Move best = search.findBestMove();
+    CHECK(scope.count() == 0);
+
+    CHECK_FALSE(best.isNull());
+    CHECK(reports == 6);
+    REQUIRE_FALSE(last.pv.empty());
+    CHECK(last.pv[0] == best);
+}
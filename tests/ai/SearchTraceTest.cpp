@@ -0,0 +1,145 @@
+#include "ai/PawnTable.h"
+#include "ai/Search.h"
+#include "ai/SearchConfig.h"
+#include "ai/SearchTrace.h"
+#include "ai/TranspositionTable.h"
+#include "core/Board.h"
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace cchess;
+
+namespace {
+
+const char* KIWIPETE = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q2/PPPBBPPP/R3K2R w KQkq - 0 1";
+
+TraceRecord recordWithScore(int score) {
+    TraceRecord r{};
+    r.score = score;
+    return r;
+}
+
+struct SearchResult {
+    Move best;
+    uint64_t nodes;
+};
+
+SearchResult searchKiwipete(SearchTrace* trace) {
+    Board board(KIWIPETE);
+    SearchConfig config;
+    config.maxDepth = 5;
+    config.searchTime = std::chrono::milliseconds(60000);
+    config.trace = trace;
+    TranspositionTable tt(16);
+    eval::PawnTable pt;
+    CorrectionHistory ch;
+    Search search(board, config, tt, pt, ch);
+    Move best = search.findBestMove();
+    return {best, search.totalNodes()};
+}
+
+}  // namespace
+
+TEST_CASE("SearchTrace: ring keeps the newest records in order", "[trace]") {
+    SearchTrace trace(5);  // rounds up to 8
+    REQUIRE(trace.capacity() == 8);
+
+    for (int i = 0; i < 11; ++i)
+        trace.record(recordWithScore(i));
+
+    CHECK(trace.recorded() == 11);
+    auto records = trace.snapshot();
+    REQUIRE(records.size() == 8);
+    for (size_t i = 0; i < records.size(); ++i)
+        CHECK(records[i].score == static_cast<int>(i) + 3);
+
+    trace.clear();
+    CHECK(trace.snapshot().empty());
+}
+
+TEST_CASE("SearchTrace: file round trip", "[trace]") {
+    SearchTrace trace(4);
+    for (int i = 0; i < 6; ++i)
+        trace.record(recordWithScore(i * 10));
+
+    std::string path = (std::filesystem::temp_directory_path() / "cchess_trace_test.bin").string();
+    REQUIRE(trace.writeTo(path));
+
+    uint64_t total = 0;
+    auto records = SearchTrace::readFrom(path, &total);
+    std::remove(path.c_str());
+
+    REQUIRE(records);
+    CHECK(total == 6);
+    REQUIRE(records->size() == 4);
+    CHECK(records->front().score == 20);
+    CHECK(records->back().score == 50);
+
+    CHECK_FALSE(SearchTrace::readFrom(path));
+}
+
+TEST_CASE("SearchTrace: summary sums subtree sizes per pruning reason", "[trace]") {
+    std::vector<TraceRecord> records(3);
+    records[0].prune = TracePrune::NullMove;
+    records[0].subtreeNodes = 10;
+    records[1].prune = TracePrune::NullMove;
+    records[1].subtreeNodes = 5;
+    records[2].prune = TracePrune::StandPat;
+    records[2].subtreeNodes = 1;
+    records[2].flags = TRACE_QUIESCENCE;
+
+    std::ostringstream summary;
+    SearchTrace::summarize(records, summary);
+
+    // Columns: main nodes, main subtree, qs nodes, qs subtree
+    auto row = [&summary](const std::string& name) {
+        std::istringstream lines(summary.str());
+        std::vector<uint64_t> fields;
+        for (std::string line; std::getline(lines, line);) {
+            if (line.rfind(name, 0) == 0) {
+                std::istringstream values(line.substr(name.size()));
+                for (uint64_t v; values >> v;)
+                    fields.push_back(v);
+            }
+        }
+        return fields;
+    };
+    CHECK(row("null-move") == std::vector<uint64_t>{2, 15, 0, 0});
+    CHECK(row("stand-pat") == std::vector<uint64_t>{0, 0, 1, 1});
+}
+
+TEST_CASE("SearchTrace: tracing does not change the search", "[trace]") {
+    SearchResult plain = searchKiwipete(nullptr);
+
+    SearchTrace trace;
+    SearchResult traced = searchKiwipete(&trace);
+
+    CHECK(traced.best == plain.best);
+    CHECK(traced.nodes == plain.nodes);
+
+    // A record per visit (null-move and LMR re-search visits are not counted as nodes),
+    // and one root summary per completed iteration
+    auto records = trace.snapshot();
+    auto roots = std::count_if(records.begin(), records.end(),
+                               [](const TraceRecord& r) { return r.flags & TRACE_ROOT; });
+    CHECK(roots == 5);
+    CHECK(trace.recorded() > plain.nodes + 5);
+
+    // Post-order: the last record is the final iteration's root, carrying the best move
+    const TraceRecord& last = records.back();
+    CHECK((last.flags & TRACE_ROOT));
+    CHECK(last.depth == 5);
+    TTEntry encoded;
+    encoded.move16 = last.move;
+    CHECK(encoded.bestMove() == plain.best);
+
+    std::ostringstream summary;
+    SearchTrace::summarize(records, summary);
+    CHECK(summary.str().find("iteration depth 5") != std::string::npos);
+}
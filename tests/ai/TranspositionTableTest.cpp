@@ -1,6 +1,8 @@
+#include "ai/TTDiagnostics.h"
 #include "ai/TranspositionTable.h"
 
 #include <catch2/catch_test_macros.hpp>
+#include <sstream>
 
 using namespace cchess;
 
@@ -25,6 +27,24 @@ TEST_CASE("TT store then probe returns matching entry", "[tt]") {
     REQUIRE(entry.bestMove() == move);
 }
 
+TEST_CASE("TT keeps the static eval of a position", "[tt]") {
+    TranspositionTable tt(1);
+    uint64_t hash = 0x2222222222222222ULL;
+    Move move(makeSquare(FILE_E, RANK_2), makeSquare(FILE_E, RANK_4));
+
+    tt.store(hash, 10, 5, TTBound::LOWER, move);
+    TTEntry entry;
+    REQUIRE(tt.probe(hash, entry));
+    CHECK(entry.eval == TTEntry::NO_EVAL);
+
+    // A shallower result is dropped, but still fills in the missing eval
+    tt.store(hash, 30, 2, TTBound::UPPER, move, -75);
+    REQUIRE(tt.probe(hash, entry));
+    CHECK(entry.depth == 5);
+    CHECK(entry.score == 10);
+    CHECK(entry.eval == -75);
+}
+
 TEST_CASE("TT always-replace overwrites", "[tt]") {
     TranspositionTable tt(1);
     uint64_t hash = 0x1111111111111111ULL;
@@ -88,6 +108,47 @@ TEST_CASE("TT table size is power of 2", "[tt]") {
     REQUIRE((count & (count - 1)) == 0);
 }
 
+TEST_CASE("TT hot table keeps shallow entries out of the main table", "[tt]") {
+    TranspositionTable tt(1);
+    tt.setHotTable(64);
+    REQUIRE(tt.hotClusterCount() == 64 * 1024 / sizeof(TTCluster));
+
+    uint64_t shallow = 0x1111111111111111ULL;
+    uint64_t deep = 0x2222222222222222ULL;
+    Move move(makeSquare(FILE_E, RANK_2), makeSquare(FILE_E, RANK_4));
+    tt.store(shallow, 10, 0, TTBound::EXACT, move);
+    tt.store(deep, 20, 6, TTBound::LOWER, move);
+    CHECK(tt.stats().hotStores == 1);
+    CHECK(tt.usedEntries() == 1);  // only the deep entry is in the main table
+
+    TTEntry entry;
+    REQUIRE(tt.probe(shallow, entry, 0));
+    CHECK(entry.score == 10);
+    REQUIRE(tt.probe(shallow, entry));  // deep probes fall back to the hot table
+    CHECK(entry.bestMove() == move);
+    CHECK_FALSE(tt.probe(deep, entry, 1));  // shallow probes never reach the main table
+    REQUIRE(tt.probe(deep, entry, 6));
+    CHECK(entry.score == 20);
+
+    tt.setHotTable(0);
+    CHECK(tt.hotClusterCount() == 0);
+    CHECK_FALSE(tt.probe(shallow, entry, 0));
+    tt.store(shallow, 10, 0, TTBound::EXACT, move);
+    CHECK(tt.probe(shallow, entry, 0));
+}
+
+TEST_CASE("TT resize reallocates an empty table", "[tt]") {
+    TranspositionTable tt(1);
+    uint64_t hash = 0xAAAAAAAAAAAAAAAAULL;
+    Move move(makeSquare(FILE_A, RANK_1), makeSquare(FILE_A, RANK_2));
+    tt.store(hash, 99, 7, TTBound::EXACT, move);
+
+    tt.resize(4);
+    REQUIRE(tt.clusterCount() * sizeof(TTCluster) == 4 * 1024 * 1024);
+    TTEntry entry;
+    REQUIRE_FALSE(tt.probe(hash, entry));
+}
+
 TEST_CASE("TT generation aging replaces stale entries when cluster is full", "[tt]") {
     TranspositionTable tt(1);
     // All 5 hashes map to the same cluster index (same lower bits), different verify keys.
@@ -119,3 +180,54 @@ TEST_CASE("TT generation aging replaces stale entries when cluster is full", "[t
     REQUIRE(tt.probe(hashes[4], entry));
     REQUIRE(entry.score == 99);
 }
+
+TEST_CASE("TT sample histograms depth, bound and age", "[tt]") {
+    TranspositionTable tt(1);
+    size_t clusters = tt.clusterCount();
+
+    // All three land in cluster 0 (low bits) with different verify keys (high bits)
+    tt.store(0x1000000000000000ULL, 10, 0, TTBound::UPPER, Move{});
+    tt.store(0x2000000000000000ULL, 10, 7, TTBound::LOWER, Move{});
+    tt.newSearch();
+    tt.newSearch();
+    tt.store(0x3000000000000000ULL, 10, 40, TTBound::EXACT, Move{});
+
+    TTDiagnostics d = tt.sample(clusters);  // every cluster
+    CHECK(d.sampledClusters == clusters);
+    CHECK(d.usedSlots() == 3);
+    CHECK(d.depth[0] == 1);
+    CHECK(d.depth[7] == 1);
+    CHECK(d.depth[TTDiagnostics::DEPTH_BUCKETS - 1] == 1);  // depth 40 clamps to the last bucket
+    CHECK(d.bound[static_cast<size_t>(TTBound::EXACT)] == 1);
+    CHECK(d.bound[static_cast<size_t>(TTBound::LOWER)] == 1);
+    CHECK(d.bound[static_cast<size_t>(TTBound::UPPER)] == 1);
+    CHECK(d.age[0][2] == 1);  // first two stores are two searches old
+    CHECK(d.age[1][2] == 1);
+    CHECK(d.age[2][0] == 1);
+
+    TTDiagnostics small = tt.sample(16);
+    CHECK(small.sampledClusters == 16);
+    CHECK(small.sampledSlots() == 64);
+}
+
+TEST_CASE("TT hit depth margins are clamped into the histogram", "[tt]") {
+    TTStats stats;
+    stats.recordHitDepth(5, 5);
+    stats.recordHitDepth(3, 5);
+    stats.recordHitDepth(30, 1);
+    stats.recordHitDepth(0, 20);
+    const int mid = TTStats::HIT_MARGIN_RANGE;
+    CHECK(stats.hitDepthMargin[static_cast<size_t>(mid)] == 1);
+    CHECK(stats.hitDepthMargin[static_cast<size_t>(mid - 2)] == 1);
+    CHECK(stats.hitDepthMargin.back() == 1);
+    CHECK(stats.hitDepthMargin.front() == 1);
+
+    TranspositionTable tt(1);
+    tt.stats() = stats;
+    std::ostringstream out;
+    tt.sample().print(out);
+    CHECK(out.str().find("4 hits") != std::string::npos);
+
+    stats.reset();
+    CHECK(stats.hitDepthMargin[static_cast<size_t>(mid)] == 0);
+}
@@ -0,0 +1,94 @@
+#include "core/Board.h"
+#include "core/Notation.h"
+#include "core/Square.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+using namespace cchess;
+
+static Square sq(const char* s) {
+    return *stringToSquare(s);
+}
+
+TEST_CASE("sanToMove: pawn and piece moves from the start position", "[notation]") {
+    Board board;
+    auto e4 = sanToMove(board, "e4");
+    REQUIRE(e4);
+    CHECK(e4->from() == sq("e2"));
+    CHECK(e4->to() == sq("e4"));
+
+    auto nf3 = sanToMove(board, "Nf3");
+    REQUIRE(nf3);
+    CHECK(nf3->from() == sq("g1"));
+
+    CHECK_FALSE(sanToMove(board, "e5"));
+    CHECK_FALSE(sanToMove(board, "Qh5"));
+}
+
+TEST_CASE("sanToMove: disambiguation, suffixes and castling", "[notation]") {
+    // Knights on b1 and f3 can both reach d2; castling available on the king side
+    Board board("4k3/8/8/8/8/5N2/8/RN2K2R w KQ - 0 1");
+
+    auto nbd2 = sanToMove(board, "Nbd2");
+    REQUIRE(nbd2);
+    CHECK(nbd2->from() == sq("b1"));
+    CHECK_FALSE(sanToMove(board, "Nd2"));  // ambiguous without the file
+
+    auto castle = sanToMove(board, "O-O+!");
+    REQUIRE(castle);
+    CHECK(castle->isCastling());
+    CHECK(sanToMove(board, "0-0") == castle);
+}
+
+TEST_CASE("sanToMove: promotion round-trips through moveToSan", "[notation]") {
+    Board board("8/4P1k1/8/8/8/8/8/4K3 w - - 0 1");
+    auto promo = sanToMove(board, "e8=N");
+    REQUIRE(promo);
+    CHECK(promo->promotion() == PieceType::Knight);
+    CHECK(moveToSan(board, *promo) == "e8=N+");
+}
+
+TEST_CASE("movesToSan: matches moveToSan for every legal move", "[notation]") {
+    const char* fens[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "4k3/8/8/8/8/5N2/8/RN2K2R w KQ - 0 1",
+        "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1",  // Rd8#
+        "8/4P1k1/8/8/8/8/8/4K3 w - - 0 1",
+    };
+    for (const char* fen : fens) {
+        Board board(fen);
+        MoveList legal = board.getLegalMoves();
+        auto sans = movesToSan(board, legal);
+        REQUIRE(sans.size() == legal.size());
+        for (size_t i = 0; i < legal.size(); ++i)
+            CHECK(sans[i] == moveToSan(board, legal[i]));
+    }
+
+    Board mate("6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1");
+    auto rd8 = sanToMove(mate, "Rd8");
+    REQUIRE(rd8);
+    CHECK(moveToSan(mate, *rd8) == "Rd8#");
+}
+
+TEST_CASE("pvToSan: renders a line and stops at an illegal move", "[notation]") {
+    Board board;
+    std::vector<Move> line;
+    Board walk;
+    for (const char* san : {"e4", "e5", "Qh5", "Nc6", "Bc4", "Nf6", "Qxf7"}) {
+        auto m = sanToMove(walk, san);
+        REQUIRE(m);
+        line.push_back(*m);
+        walk.makeMoveUnchecked(*m);
+    }
+
+    auto sans = pvToSan(board, line);
+    REQUIRE(sans.size() == line.size());
+    CHECK(sans.front() == "e4");
+    CHECK(sans[2] == "Qh5");
+    CHECK(sans.back() == "Qxf7#");
+
+    line.insert(line.begin() + 2, line[0]);  // e2e4 again: illegal for Black
+    CHECK(pvToSan(board, line).size() == 2);
+    CHECK(pvToSan(board, std::vector<Move>{}).empty());
+}
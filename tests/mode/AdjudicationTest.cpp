@@ -0,0 +1,91 @@
+#include "core/Board.h"
+#include "mode/Adjudication.h"
+#include "uci/UciEngine.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+using namespace cchess;
+
+TEST_CASE("Adjudication: resign needs both engines to agree", "[adjudication]") {
+    AdjudicationConfig config;
+    config.resignScore = 500;
+    config.resignMoves = 2;
+    Adjudicator adj(config);
+
+    // White's engine thinks White is lost, Black's engine does not yet
+    CHECK(adj.update(Color::White, 30, -600) == Adjudication::None);
+    CHECK(adj.update(Color::Black, 30, -100) == Adjudication::None);
+    CHECK(adj.update(Color::White, 31, -650) == Adjudication::None);
+    CHECK(adj.update(Color::Black, 31, -700) == Adjudication::None);
+    CHECK(adj.update(Color::White, 32, -700) == Adjudication::None);
+    CHECK(adj.update(Color::Black, 32, -800) == Adjudication::BlackWins);
+}
+
+TEST_CASE("Adjudication: a missing score resets the run", "[adjudication]") {
+    AdjudicationConfig config;
+    config.resignScore = 500;
+    config.resignMoves = 2;
+    Adjudicator adj(config);
+
+    adj.update(Color::White, 20, 900);
+    adj.update(Color::Black, 20, 900);
+    CHECK(adj.update(Color::White, 21, std::nullopt) == Adjudication::None);
+    CHECK(adj.update(Color::Black, 21, 900) == Adjudication::None);
+    CHECK(adj.update(Color::White, 22, 900) == Adjudication::None);
+    CHECK(adj.update(Color::Black, 22, 900) == Adjudication::None);
+    CHECK(adj.update(Color::White, 23, 900) == Adjudication::WhiteWins);
+}
+
+TEST_CASE("Adjudication: draws only after the configured move", "[adjudication]") {
+    AdjudicationConfig config;
+    config.drawScore = 10;
+    config.drawMoves = 2;
+    config.drawMoveNumber = 40;
+    Adjudicator adj(config);
+
+    for (int move = 30; move < 40; ++move) {
+        CHECK(adj.update(Color::White, move, 5) == Adjudication::None);
+        CHECK(adj.update(Color::Black, move, -3) == Adjudication::None);
+    }
+    CHECK(adj.update(Color::White, 40, 0) == Adjudication::Draw);
+
+    config.enabled = false;
+    Adjudicator off(config);
+    for (int move = 40; move < 50; ++move) {
+        CHECK(off.update(Color::White, move, 0) == Adjudication::None);
+        CHECK(off.update(Color::Black, move, 0) == Adjudication::None);
+    }
+}
+
+TEST_CASE("Adjudication: threefold repetition from hash history", "[adjudication]") {
+    Board board;
+    std::vector<uint64_t> hashes = {board.position().hash()};
+    const std::vector<std::string> shuffle = {"g1f3", "g8f6", "f3g1", "f6g8"};
+
+    int repeatedAt = -1;
+    for (int i = 0; i < 12 && repeatedAt < 0; ++i) {
+        auto move = Move::fromAlgebraic(shuffle[static_cast<size_t>(i % 4)]);
+        REQUIRE(move);
+        REQUIRE(board.makeMove(*move));
+        hashes.push_back(board.position().hash());
+        if (isThreefoldRepetition(hashes, board.halfmoveClock()))
+            repeatedAt = i + 1;
+    }
+    // The start position occurs for the third time after two full shuffles
+    CHECK(repeatedAt == 8);
+
+    // A pawn move since the earlier occurrences makes them unreachable
+    CHECK_FALSE(isThreefoldRepetition(hashes, 2));
+}
+
+TEST_CASE("Adjudication: scores from UCI info lines", "[adjudication]") {
+    CHECK(parseInfoScore("info depth 12 seldepth 18 score cp 34 nodes 1000 pv e2e4") == 34);
+    CHECK(parseInfoScore("info depth 3 score cp -250 lowerbound") == -250);
+    CHECK(parseInfoScore("info depth 9 score mate 2 pv d1h5") > 99000);
+    CHECK(parseInfoScore("info depth 9 score mate -1") < -99000);
+    CHECK(*parseInfoScore("info score mate 1") > *parseInfoScore("info score mate 2"));
+    CHECK_FALSE(parseInfoScore("info string hello").has_value());
+    CHECK_FALSE(parseInfoScore("info currmove e2e4 currmovenumber 1").has_value());
+}
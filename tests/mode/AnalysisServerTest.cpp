@@ -0,0 +1,186 @@
+#ifndef _WIN32
+
+#include "mode/AnalysisServer.h"
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cchess;
+
+namespace {
+
+// A session connected to a TestServer. Received lines are kept in order.
+class Client {
+public:
+    explicit Client(const std::string& path) {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+        // The server may still be starting up
+        for (int attempt = 0; attempt < 500 && !connected_; ++attempt) {
+            fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (::connect(fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0) {
+                connected_ = true;
+            } else {
+                ::close(fd_);
+                fd_ = -1;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+    }
+    ~Client() {
+        if (fd_ >= 0)
+            ::close(fd_);
+    }
+
+    bool connected() const { return connected_; }
+
+    void send(const std::string& line) {
+        std::string data = line + "\n";
+        if (fd_ >= 0)
+            ::send(fd_, data.data(), data.size(), 0);
+    }
+
+    // Reads until a line starting with prefix arrives and returns it; empty on timeout.
+    std::string waitFor(const std::string& prefix,
+                        std::chrono::milliseconds timeout = std::chrono::seconds(20)) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (size_t next = 0;;) {
+            for (; next < lines_.size(); ++next) {
+                if (lines_[next].rfind(prefix, 0) == 0)
+                    return lines_[next];
+            }
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+            if (left.count() <= 0 || !readMore(static_cast<int>(left.count())))
+                return "";
+        }
+    }
+
+    bool received(const std::string& prefix) const {
+        for (const auto& line : lines_)
+            if (line.rfind(prefix, 0) == 0)
+                return true;
+        return false;
+    }
+
+private:
+    bool readMore(int timeoutMs) {
+        pollfd p{fd_, POLLIN, 0};
+        if (::poll(&p, 1, timeoutMs) <= 0)
+            return false;
+        char chunk[4096];
+        ssize_t n = ::recv(fd_, chunk, sizeof(chunk), 0);
+        if (n <= 0)
+            return false;
+        buffer_.append(chunk, static_cast<size_t>(n));
+        for (size_t newline; (newline = buffer_.find('\n')) != std::string::npos;) {
+            lines_.push_back(buffer_.substr(0, newline));
+            buffer_.erase(0, newline + 1);
+        }
+        return true;
+    }
+
+    int fd_ = -1;
+    bool connected_ = false;
+    std::string buffer_;
+    std::vector<std::string> lines_;
+};
+
+// Runs a server on a temporary socket for the lifetime of the object.
+class TestServer {
+public:
+    explicit TestServer(const std::string& name, int threads = 1) {
+        options_.socketPath = (std::filesystem::temp_directory_path() / name).string();
+        options_.threads = threads;
+        options_.hashMB = 1;
+        std::filesystem::remove(options_.socketPath);
+        thread_ = std::thread([this]() { exitCode_ = AnalysisServer::run(options_); });
+    }
+    ~TestServer() {
+        if (!thread_.joinable())
+            return;
+        // A failed check skipped the test's shutdown
+        Client(options_.socketPath).send("shutdown");
+        thread_.join();
+    }
+
+    const std::string& path() const { return options_.socketPath; }
+
+    // Waits for run() to return, after a client has sent "shutdown"
+    int join() {
+        thread_.join();
+        return exitCode_;
+    }
+
+private:
+    AnalysisServerOptions options_;
+    std::thread thread_;
+    int exitCode_ = -1;
+};
+
+}  // namespace
+
+TEST_CASE("AnalysisServer: tagged replies to go, isready and bad commands", "[server]") {
+    TestServer server("cchess_server_test.sock");
+    {
+        Client client(server.path());
+        REQUIRE(client.connected());
+
+        client.send("isready");
+        CHECK(client.waitFor("readyok") == "readyok");
+        client.send("bogus");
+        CHECK(client.waitFor("error ") == "error unknown command: bogus");
+
+        client.send("position startpos moves e2e4");
+        client.send("go request a depth 3");
+        std::string best = client.waitFor("bestmove request a ");
+        REQUIRE_FALSE(best.empty());
+        CHECK(best.size() > std::string("bestmove request a ").size());
+        CHECK(client.received("info request a depth 1 "));
+        CHECK(client.received("info request a depth 3 "));
+
+        // Untagged requests are numbered per session
+        client.send("go depth 1");
+        CHECK_FALSE(client.waitFor("bestmove request 1 ").empty());
+
+        client.send("shutdown");
+    }
+    CHECK(server.join() == 0);
+}
+
+TEST_CASE("AnalysisServer: stop cancels running and queued requests", "[server]") {
+    TestServer server("cchess_server_cancel.sock");
+    {
+        Client client(server.path());
+        REQUIRE(client.connected());
+
+        // One worker: "queued" waits behind "long"
+        client.send("go request long movetime 60000");
+        REQUIRE_FALSE(client.waitFor("info request long depth 1 ").empty());
+        client.send("go request queued depth 30");
+
+        client.send("stop queued");
+        client.send("stop");  // everything left in the session
+        CHECK_FALSE(client.waitFor("cancelled request long", std::chrono::seconds(10)).empty());
+        CHECK_FALSE(
+            client.waitFor("cancelled request queued", std::chrono::seconds(10)).empty());
+        CHECK_FALSE(client.received("bestmove request long"));
+        CHECK_FALSE(client.received("bestmove request queued"));
+
+        client.send("shutdown");
+    }
+    CHECK(server.join() == 0);
+}
+
+#endif  // _WIN32
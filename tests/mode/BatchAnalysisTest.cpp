@@ -0,0 +1,103 @@
+#include "core/Board.h"
+#include "mode/BatchAnalysis.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace cchess;
+
+TEST_CASE("BatchAnalysis: EPD lines become jobs with ids", "[analyse]") {
+    std::istringstream in(
+        "# comment\n"
+        "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 bm e5; id \"open.1\";\n"
+        "\n"
+        "8/8/8/8/8/8/8/8 w - - id \"invalid\";\n"
+        "4k3/8/8/8/8/8/8/4K2R w K - 3 40\n");
+    auto jobs = BatchAnalysis::parseEpd(in);
+
+    REQUIRE(jobs.size() == 2);
+    CHECK(jobs[0].id == "open.1");
+    CHECK(jobs[0].fen == "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1");
+    CHECK(jobs[1].id == "line 5");
+    CHECK(jobs[1].fen == "4k3/8/8/8/8/8/8/4K2R w K - 3 40");
+}
+
+TEST_CASE("BatchAnalysis: PGN mainline positions with history", "[analyse]") {
+    std::istringstream in(
+        "[Event \"Test\"]\n"
+        "[White \"A\"]\n"
+        "\n"
+        "1. e4 {best by test} e5 (1... c5 2. Nf3) 2. Nf3 $1 Nc6 1-0\n"
+        "\n"
+        "[Event \"Second\"]\n"
+        "[FEN \"4k3/8/8/8/8/8/8/4K2R w K - 0 1\"]\n"
+        "\n"
+        "1. O-O Kd7 2. Zz9 Kc6 *\n");
+    auto jobs = BatchAnalysis::parsePgn(in);
+
+    // Game 1: 4 positions; game 2 stops at the unparseable move after 2 positions
+    REQUIRE(jobs.size() == 6);
+    CHECK(jobs[0].id == "game 1 ply 1");
+    CHECK(jobs[0].fen == Board::STARTING_FEN);
+    CHECK(jobs[0].gameHistory.empty());
+    CHECK(jobs[3].id == "game 1 ply 4");
+    CHECK(jobs[3].gameHistory.size() == 3);
+    CHECK(jobs[4].id == "game 2 ply 1");
+    CHECK(jobs[4].fen == "4k3/8/8/8/8/8/8/4K2R w K - 0 1");
+    CHECK(jobs[5].id == "game 2 ply 2");
+}
+
+namespace {
+
+// Runs the analysis and returns its stdout lines, parsed
+std::vector<nlohmann::json> runCaptured(const BatchAnalysisOptions& options) {
+    std::ostringstream out;
+    std::streambuf* saved = std::cout.rdbuf(out.rdbuf());
+    int status = BatchAnalysis::run(options);
+    std::cout.rdbuf(saved);
+    REQUIRE(status == 0);
+
+    std::vector<nlohmann::json> lines;
+    std::istringstream in(out.str());
+    for (std::string line; std::getline(in, line);)
+        lines.push_back(nlohmann::json::parse(line));
+    return lines;
+}
+
+}  // namespace
+
+TEST_CASE("BatchAnalysis: results do not depend on the thread count", "[analyse]") {
+    std::string path = (std::filesystem::temp_directory_path() / "cchess_batch.epd").string();
+    {
+        std::ofstream epd(path);
+        epd << "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - id \"kiwi\";\n"
+            << "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - id \"two\";\n"
+            << "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - id \"end\";\n"
+            << "r2q1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP1QBPPP/R3K2R w KQ - id \"qgd\";\n";
+    }
+    BatchAnalysisOptions options;
+    options.inputPath = path;
+    options.depth = 5;
+    options.hashMB = 1;
+
+    options.threads = 1;
+    auto single = runCaptured(options);
+    options.threads = 3;
+    auto several = runCaptured(options);
+
+    REQUIRE(single.size() == 4);
+    REQUIRE(several.size() == 4);
+    for (size_t i = 0; i < single.size(); ++i) {
+        CHECK(several[i].at("id") == single[i].at("id"));
+        CHECK(several[i].at("bestmove") == single[i].at("bestmove"));
+        CHECK(several[i].at("score") == single[i].at("score"));
+        CHECK(several[i].at("nodes") == single[i].at("nodes"));
+    }
+    std::filesystem::remove(path);
+}
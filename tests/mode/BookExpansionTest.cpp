@@ -0,0 +1,136 @@
+#include "book/PolyglotBook.h"
+#include "core/Board.h"
+#include "mode/BookExpansion.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <string>
+
+using namespace cchess;
+
+namespace {
+
+BookExpansionOptions tempOptions(const std::string& name) {
+    auto dir = std::filesystem::temp_directory_path();
+    BookExpansionOptions options;
+    options.bookPath = (dir / (name + ".bin")).string();
+    options.checkpointPath = (dir / (name + ".json")).string();
+    std::filesystem::remove(options.bookPath);
+    std::filesystem::remove(options.checkpointPath);
+    options.nodes = 1000;
+    options.threads = 2;
+    options.hashMB = 1;
+    options.maxPly = 3;
+    return options;
+}
+
+}  // namespace
+
+TEST_CASE("BookExpansion: Polyglot moves round-trip", "[book]") {
+    // Castling both ways and under-promotions
+    Board board("r3k2r/1P6/8/8/8/8/8/R3K2R w KQkq - 0 1");
+    for (const Move& move : board.getLegalMoves()) {
+        auto decoded = book::decodePolyglotMove(book::encodePolyglotMove(move), board);
+        REQUIRE(decoded);
+        CHECK(*decoded == move);
+    }
+    auto castle = board.findLegalMove(makeSquare(FILE_E, RANK_1), makeSquare(FILE_G, RANK_1));
+    REQUIRE(castle);
+    CHECK((book::encodePolyglotMove(*castle) & 0x3F) == makeSquare(FILE_H, RANK_1));
+}
+
+TEST_CASE("BookExpansion: written books load back", "[book]") {
+    Board board;
+    uint64_t key = book::computePolyglotKey(board.position());
+    auto e4 = board.findLegalMove(makeSquare(FILE_E, RANK_2), makeSquare(FILE_E, RANK_4));
+    REQUIRE(e4);
+
+    std::string path = (std::filesystem::temp_directory_path() / "cchess_book_write.bin").string();
+    REQUIRE(book::writePolyglotBook(path, {{key, book::encodePolyglotMove(*e4), 10, 0},
+                                           {key ^ 1, 0x1234, 5, 0}}));
+    book::PolyglotBook loaded;
+    REQUIRE(loaded.load(path));
+    auto probed = loaded.probe(key);
+    REQUIRE(probed);
+    CHECK(book::decodePolyglotMove(*probed, board) == e4);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("BookExpansion: expands the main line first and resumes", "[book]") {
+    BookExpansionOptions options = tempOptions("cchess_expand_test");
+    BookExpansion expansion(options);
+    REQUIRE_FALSE(expansion.loadCheckpoint());
+    expansion.addRoot(Board::STARTING_FEN);
+    int expanded = 0;
+    while (expansion.expandNext())
+        ++expanded;
+    CHECK(expanded > 1);
+    CHECK(expansion.writeBook() > 0);
+    REQUIRE(expansion.saveCheckpoint());
+
+    const auto& nodes = expansion.nodes();
+    REQUIRE(nodes.size() > 1);
+    for (const auto& [key, node] : nodes) {
+        CHECK(node.ply <= options.maxPly);
+        if (node.ply == options.maxPly)
+            CHECK_FALSE(node.expanded);
+    }
+
+    // The root was expanded with a score for every legal move
+    Board start;
+    auto root = nodes.find(book::computePolyglotKey(start.position()));
+    REQUIRE(root != nodes.end());
+    CHECK(root->second.expanded);
+    CHECK(root->second.moves.size() == 20);
+
+    book::PolyglotBook book;
+    REQUIRE(book.load(options.bookPath));
+    auto move = book.probe(root->first);
+    REQUIRE(move);
+    CHECK(book::decodePolyglotMove(*move, start));
+
+    // A fresh run resumes from the checkpoint with the same tree
+    BookExpansion resumed(options);
+    REQUIRE(resumed.loadCheckpoint());
+    CHECK(resumed.nodes().size() == nodes.size());
+    CHECK(resumed.expandNext() == nullptr);
+
+    std::filesystem::remove(options.bookPath);
+    std::filesystem::remove(options.checkpointPath);
+}
+
+TEST_CASE("BookExpansion: grows an existing book instead of replacing it", "[book]") {
+    BookExpansionOptions options = tempOptions("cchess_expand_merge");
+    options.maxPly = 1;
+    Board start;
+    uint64_t rootKey = book::computePolyglotKey(start.position());
+    constexpr uint64_t otherKey = 0x0123456789ABCDEFULL;
+    REQUIRE(book::writePolyglotBook(options.bookPath,
+                                    {{otherKey, 0x0123, 7, 0}, {rootKey, 0x0FFF, 9, 0}}));
+
+    BookExpansion expansion(options);
+    expansion.addRoot(Board::STARTING_FEN);
+    REQUIRE(expansion.expandNext());
+    size_t written = expansion.writeBook();
+
+    auto entries = book::readPolyglotBook(options.bookPath);
+    CHECK(entries.size() == written);
+    CHECK_FALSE(std::filesystem::exists(options.bookPath + ".tmp"));
+    size_t other = 0;
+    size_t root = 0;
+    for (const auto& e : entries) {
+        if (e.key == otherKey) {
+            ++other;
+            CHECK(e.move == 0x0123);
+        } else if (e.key == rootKey) {
+            ++root;
+            CHECK(e.move != 0x0FFF);  // the analysed position replaces the old entry
+            CHECK(e.weight >= 1);
+        }
+    }
+    CHECK(other == 1);
+    CHECK(root > 0);
+
+    std::filesystem::remove(options.bookPath);
+    std::filesystem::remove(options.checkpointPath);
+}
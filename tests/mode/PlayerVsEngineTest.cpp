@@ -0,0 +1,37 @@
+#include "core/Board.h"
+#include "mode/PlayerVsEngine.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace cchess;
+
+TEST_CASE("PlayerVsEngine: coordinate and SAN input", "[pve]") {
+    Board board;
+
+    auto coord = PlayerVsEngine::parseMove(board, "e2e4");
+    REQUIRE(coord);
+    CHECK(coord->toAlgebraic() == "e2e4");
+
+    auto spaced = PlayerVsEngine::parseMove(board, "G1 F3");
+    REQUIRE(spaced);
+    CHECK(spaced->toAlgebraic() == "g1f3");
+
+    auto san = PlayerVsEngine::parseMove(board, "Nc3");
+    REQUIRE(san);
+    CHECK(san->toAlgebraic() == "b1c3");
+
+    CHECK_FALSE(PlayerVsEngine::parseMove(board, "e2e5"));
+    CHECK_FALSE(PlayerVsEngine::parseMove(board, "hello"));
+}
+
+TEST_CASE("PlayerVsEngine: bare coordinate promotion defaults to a queen", "[pve]") {
+    Board board("8/4P1k1/8/8/8/8/8/4K3 w - - 0 1");
+
+    auto queen = PlayerVsEngine::parseMove(board, "e7e8");
+    REQUIRE(queen);
+    CHECK(queen->toAlgebraic() == "e7e8q");
+
+    auto knight = PlayerVsEngine::parseMove(board, "e7e8n");
+    REQUIRE(knight);
+    CHECK(knight->toAlgebraic() == "e7e8n");
+}
@@ -0,0 +1,64 @@
+#include "mode/Telemetry.h"
+#include "utils/Error.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cchess;
+
+namespace {
+
+std::vector<nlohmann::json> readLines(const std::string& path) {
+    std::vector<nlohmann::json> lines;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line))
+        lines.push_back(nlohmann::json::parse(line));
+    return lines;
+}
+
+}  // namespace
+
+TEST_CASE("Telemetry: records from several threads land one per line", "[telemetry]") {
+    std::string path = (std::filesystem::temp_directory_path() / "cchess_telemetry.jsonl").string();
+    std::filesystem::remove(path);
+    {
+        TelemetryWriter telemetry(path);
+        REQUIRE(telemetry.enabled());
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+            threads.emplace_back([&telemetry, t]() {
+                for (int i = 0; i < 250; ++i)
+                    telemetry.write({{"type", "move"}, {"thread", t}, {"i", i}});
+            });
+        for (auto& th : threads)
+            th.join();
+        telemetry.flush();
+        CHECK(telemetry.written() == 1000);
+        CHECK(readLines(path).size() == 1000);
+
+        telemetry.write({{"type", "game"}});
+    }  // the destructor writes what is still queued
+
+    auto lines = readLines(path);
+    REQUIRE(lines.size() == 1001);
+    CHECK(lines.back().at("type") == "game");
+    CHECK(lines.back().contains("ts_ms"));
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Telemetry: a default writer is off", "[telemetry]") {
+    TelemetryWriter telemetry;
+    CHECK_FALSE(telemetry.enabled());
+    telemetry.write({{"type", "move"}});
+    telemetry.flush();
+    CHECK(telemetry.written() == 0);
+}
+
+TEST_CASE("Telemetry: an unwritable path throws", "[telemetry]") {
+    CHECK_THROWS_AS(TelemetryWriter("/nonexistent-dir/telemetry.jsonl"), ChessError);
+}
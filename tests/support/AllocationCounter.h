@@ -0,0 +1,24 @@
+#ifndef CCHESS_TEST_ALLOCATION_COUNTER_H
+#define CCHESS_TEST_ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+namespace cchess::test {
+
+// Number of global operator new calls made by the calling thread. The test
+// binary replaces operator new (AllocationCounter.cpp) to count them.
+uint64_t threadAllocations();
+
+// Counts the allocations the calling thread makes while it lives.
+class AllocationScope {
+public:
+    AllocationScope() : start_(threadAllocations()) {}
+    uint64_t count() const { return threadAllocations() - start_; }
+
+private:
+    uint64_t start_;
+};
+
+}  // namespace cchess::test
+
+#endif  // CCHESS_TEST_ALLOCATION_COUNTER_H
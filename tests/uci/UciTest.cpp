@@ -0,0 +1,68 @@
+#include "ai/Eval.h"
+#include "ai/Search.h"
+#include "core/Board.h"
+#include "core/Move.h"
+#include "uci/Uci.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace cchess;
+
+namespace {
+
+void parse(const std::string& args, Board& board, std::vector<uint64_t>& history) {
+    std::istringstream in(args);
+    Uci::parsePosition(in, board, history);
+}
+
+}  // namespace
+
+TEST_CASE("Uci: parsePosition applies moves and records history", "[uci]") {
+    Board board;
+    std::vector<uint64_t> history{42};  // replaced, not appended to
+
+    parse("startpos moves e2e4 e7e5 g1f3", board, history);
+    Board expected("rnbqkbnr/pppp1ppp/8/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R b KQkq - 1 2");
+    CHECK(board.toFen() == expected.toFen());
+    REQUIRE(history.size() == 3);
+    CHECK(history[0] == Board().position().hash());
+
+    parse("fen 8/8/4k3/8/8/4K3/8/8 w - - 0 1 moves e3d4 e6d6", board, history);
+    CHECK(board.toFen() == Board("8/8/3k4/8/3K4/8/8/8 w - - 2 2").toFen());
+    CHECK(history.size() == 2);
+
+    // Illegal and malformed moves are skipped
+    parse("startpos moves e2e5 xyz e2e4", board, history);
+    CHECK(history.size() == 1);
+    CHECK(board.sideToMove() == Color::Black);
+}
+
+TEST_CASE("Uci: formatInfo writes scores, pv and progress reports", "[uci]") {
+    Board board;
+    auto e4 = board.findLegalMove(makeSquare(FILE_E, RANK_2), makeSquare(FILE_E, RANK_4));
+    REQUIRE(e4);
+
+    SearchInfo info;
+    info.depth = 5;
+    info.score = 31;
+    info.nodes = 2000;
+    info.timeMs = 100;
+    info.pv.push_back(*e4);
+    CHECK(Uci::formatInfo(info) == "depth 5 score cp 31 nodes 2000 nps 20000 time 100 pv e2e4");
+
+    info.score = eval::SCORE_MATE - 3;  // mate in 2 moves
+    CHECK(Uci::formatInfo(info).find(" score mate 2 ") != std::string::npos);
+    info.score = -(eval::SCORE_MATE - 4);
+    CHECK(Uci::formatInfo(info).find(" score mate -2 ") != std::string::npos);
+
+    SearchInfo progress;
+    progress.partial = true;
+    progress.depth = 12;
+    progress.nodes = 5000;
+    progress.timeMs = 0;
+    progress.hashfull = 250;
+    CHECK(Uci::formatInfo(progress) == "depth 12 nodes 5000 nps 5000000 time 0 hashfull 250");
+}
@@ -0,0 +1,62 @@
+#include "utils/Affinity.h"
+#include "utils/Error.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+
+using namespace cchess;
+
+TEST_CASE("Affinity: parses CPU lists", "[affinity]") {
+    CHECK(parseCpuList("0-3,8,10-11") == std::vector<int>{0, 1, 2, 3, 8, 10, 11});
+    CHECK(parseCpuList(" 5 ") == std::vector<int>{5});
+    CHECK(parseCpuList("").empty());
+    CHECK_THROWS_AS(parseCpuList("3-1"), ChessError);
+    CHECK_THROWS_AS(parseCpuList("a,b"), ChessError);
+}
+
+TEST_CASE("Affinity: topology covers the online CPUs", "[affinity]") {
+    const CpuTopology& topology = CpuTopology::get();
+    REQUIRE_FALSE(topology.nodes.empty());
+    REQUIRE(topology.cpuCount() > 0);
+    const auto& first = topology.nodes.front();
+    REQUIRE_FALSE(first.cpus.empty());
+    CHECK(topology.nodeOf(first.cpus.front()) == first.id);
+    CHECK(topology.nodeOf(-1) == -1);
+}
+
+TEST_CASE("Affinity: thread placement", "[affinity]") {
+    ThreadPlacement off = ThreadPlacement::parse("");
+    CHECK_FALSE(off.enabled());
+    CHECK(off.cpuFor(0) == -1);
+    CHECK(off.describe() == "off");
+
+    ThreadPlacement list = ThreadPlacement::parse("2,4");
+    CHECK(list.cpuFor(0) == 2);
+    CHECK(list.cpuFor(1) == 4);
+    CHECK(list.cpuFor(2) == 2);
+    CHECK(list.describe() == "2,4");
+
+    // Automatic spread visits every CPU once, starting on the first node
+    ThreadPlacement spread = ThreadPlacement::parse("auto");
+    const CpuTopology& topology = CpuTopology::get();
+    CHECK(spread.cpuFor(0) == topology.nodes.front().cpus.front());
+    CHECK(spread.cpuFor(topology.cpuCount()) == spread.cpuFor(0));
+
+    CHECK_THROWS_AS(ThreadPlacement::parse("x"), ChessError);
+}
+
+#ifdef __linux__
+TEST_CASE("Affinity: pins a thread to a CPU", "[affinity]") {
+    int target = -1;
+    int seen = -2;
+    std::thread worker([&]() {
+        // The CPU the thread already runs on is always allowed
+        target = currentCpu();
+        if (pinCurrentThread(target))
+            seen = currentCpu();
+    });
+    worker.join();
+    REQUIRE(target >= 0);
+    CHECK(seen == target);
+}
+#endif
@@ -0,0 +1,50 @@
+#include "ai/Eval.h"
+#include "ai/PawnTable.h"
+#include "core/Board.h"
+#include "core/movegen/MoveGenerator.h"
+#include "utils/CpuFeatures.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+using namespace cchess;
+
+TEST_CASE("CpuFeatures: level names", "[isa]") {
+    CHECK(std::string(isaLevelName(IsaLevel::Generic)) == "generic");
+    CHECK(std::string(isaLevelName(IsaLevel::X86_64)) == "x86-64");
+    CHECK(std::string(isaLevelName(IsaLevel::X86_64_V2)) == "x86-64-v2");
+    CHECK(std::string(isaLevelName(IsaLevel::X86_64_V3)) == "x86-64-v3");
+}
+
+TEST_CASE("CpuFeatures: detected level matches the feature bits", "[isa]") {
+    const CpuFeatures& cpu = CpuFeatures::get();
+    if (cpu.level >= IsaLevel::X86_64_V2)
+        CHECK(cpu.popcnt);
+    if (cpu.level == IsaLevel::X86_64_V3)
+        CHECK((cpu.bmi1 && cpu.bmi2 && cpu.avx2));
+#if defined(__x86_64__)
+    CHECK(cpu.level != IsaLevel::Generic);
+#endif
+}
+
+TEST_CASE("CpuFeatures: active level", "[isa]") {
+    CHECK(activeIsaLevel() >= compiledIsaLevel());
+    if (isaDispatchEnabled())
+        CHECK(activeIsaLevel() >= CpuFeatures::get().level);
+    else
+        CHECK(activeIsaLevel() == compiledIsaLevel());
+    CHECK(describeIsa().rfind(isaLevelName(activeIsaLevel()), 0) == 0);
+}
+
+// Whichever clone the loader picked must agree with the fixed reference counts and eval
+TEST_CASE("CpuFeatures: dispatched kernels give the same results", "[isa]") {
+    Board board("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    const Position& pos = board.position();
+    CHECK(MoveGenerator::generateLegalMoves(pos).size() == 48);
+    CHECK(MoveGenerator::generateLegalCaptures(pos).size() == 8);
+    CHECK(eval::gamePhase(pos) == 24);
+    CHECK(eval::evaluate(pos) == 37);
+    eval::PawnTable pawnTable;
+    CHECK(eval::evaluate(pos, pawnTable) == 37);  // fills the entry
+    CHECK(eval::evaluate(pos, pawnTable) == 37);  // reads it back
+}
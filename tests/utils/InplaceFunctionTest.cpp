@@ -0,0 +1,46 @@
+#include "utils/InplaceFunction.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+
+using namespace cchess;
+
+TEST_CASE("InplaceFunction: empty and callable states", "[inplace]") {
+    InplaceFunction<int(int)> empty;
+    CHECK_FALSE(empty);
+
+    InplaceFunction<int(int)> nullFn = nullptr;
+    CHECK_FALSE(nullFn);
+
+    int offset = 10;
+    InplaceFunction<int(int)> add = [&offset](int x) { return x + offset; };
+    REQUIRE(add);
+    CHECK(add(5) == 15);
+    offset = 20;
+    CHECK(add(5) == 25);
+
+    add = nullptr;
+    CHECK_FALSE(add);
+}
+
+TEST_CASE("InplaceFunction: copy and move keep the callable alive", "[inplace]") {
+    auto counter = std::make_shared<int>(0);
+    InplaceFunction<void()> fn = [counter] { ++*counter; };
+    CHECK(counter.use_count() == 2);
+
+    InplaceFunction<void()> copy = fn;
+    CHECK(counter.use_count() == 3);
+    copy();
+    fn();
+    CHECK(*counter == 2);
+
+    InplaceFunction<void()> moved = std::move(fn);
+    CHECK_FALSE(fn);
+    CHECK(counter.use_count() == 3);
+    moved();
+    CHECK(*counter == 3);
+
+    copy = nullptr;
+    moved = nullptr;
+    CHECK(counter.use_count() == 1);
+}
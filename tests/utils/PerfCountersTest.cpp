@@ -0,0 +1,36 @@
+#include "utils/PerfCounters.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace cchess;
+
+TEST_CASE("PerfReading: differences skip events missing on either side", "[perf]") {
+    PerfReading before;
+    before.values[static_cast<size_t>(PerfEvent::Cycles)] = 1000;
+    before.values[static_cast<size_t>(PerfEvent::Instructions)] = 1500;
+
+    PerfReading after;
+    after.values[static_cast<size_t>(PerfEvent::Cycles)] = 3000;
+    after.values[static_cast<size_t>(PerfEvent::Instructions)] = 5500;
+    after.values[static_cast<size_t>(PerfEvent::BranchMisses)] = 42;
+
+    PerfReading delta = after.since(before);
+    CHECK(delta[PerfEvent::Cycles] == 2000u);
+    CHECK(delta[PerfEvent::Instructions] == 4000u);
+    CHECK_FALSE(delta[PerfEvent::BranchMisses]);
+    REQUIRE(delta.ipc());
+    CHECK(*delta.ipc() == 2.0);
+}
+
+TEST_CASE("PerfCounters: unavailable counters read as empty", "[perf]") {
+    PerfCounters counters;
+    counters.start();
+    PerfReading reading = counters.read();
+    counters.stop();
+
+    if (!counters.available()) {
+        CHECK_FALSE(counters.reason().empty());
+        for (const auto& value : reading.values)
+            CHECK_FALSE(value);
+    }
+}